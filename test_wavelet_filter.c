@@ -7,12 +7,21 @@
  * It covers different wavelet types, thresholding strategies, and edge cases.
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
+#include <pthread.h>
 #include "wavelet_filter.h"
+#ifdef WAVELET_WITH_SERVICE
+#include <signal.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#endif
 
 #define TEST_SIGNAL_LENGTH 256
 #define PI 3.14159265358979323846
@@ -138,8 +147,6 @@ void test_spike_removal_db4() {
     config.wavelet = WAVELET_DB4;
     config.threshold_type = THRESHOLD_HARD;
     config.threshold_value = 10000;
-    config.decomposition_levels = 1; // Modified for debugging
-
     wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
 
     int16_t original_val1 = (int16_t)(100.0 * sin(2 * PI * (TEST_SIGNAL_LENGTH / 4) / (double)TEST_SIGNAL_LENGTH));
@@ -157,8 +164,6 @@ void test_spike_removal_haar() {
     config.wavelet = WAVELET_HAAR;
     config.threshold_type = THRESHOLD_SOFT;
     config.threshold_value = 10000;
-    config.decomposition_levels = 1; // Modified for debugging
-
     wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
 
     int16_t original_val1 = (int16_t)(100.0 * sin(2 * PI * (TEST_SIGNAL_LENGTH / 4) / (double)TEST_SIGNAL_LENGTH));
@@ -167,6 +172,1307 @@ void test_spike_removal_haar() {
     ASSERT(spike_removed, "Spikes are removed with Haar soft thresholding");
 }
 
+void test_decompose_reconstruct() {
+    printf("\n--- Running test_decompose_reconstruct ---\n");
+    int16_t pyramid[TEST_SIGNAL_LENGTH];
+    int16_t reconstructed[TEST_SIGNAL_LENGTH];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.wavelet = WAVELET_DB6;
+    config.decomposition_levels = 4;
+
+    int levels = wavelet_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, pyramid);
+    ASSERT(levels == 4, "Decomposition reports the effective number of levels");
+    ASSERT(wavelet_band_offset(TEST_SIGNAL_LENGTH, 4, 0) == 0 &&
+           wavelet_band_offset(TEST_SIGNAL_LENGTH, 4, 4) == TEST_SIGNAL_LENGTH / 16 &&
+           wavelet_band_offset(TEST_SIGNAL_LENGTH, 4, 1) == TEST_SIGNAL_LENGTH / 2,
+           "Pyramid bands follow the Mallat layout");
+
+    // cD_1 must match a single-level dwt() of the input.
+    int16_t approx1[TEST_SIGNAL_LENGTH / 2];
+    int16_t detail1[TEST_SIGNAL_LENGTH / 2];
+    dwt(original_signal, approx1, detail1, TEST_SIGNAL_LENGTH, config.wavelet, config.q_format);
+    ASSERT(memcmp(detail1, pyramid + TEST_SIGNAL_LENGTH / 2, sizeof(detail1)) == 0,
+           "Finest detail band matches a single-level DWT");
+
+    wavelet_reconstruct(pyramid, TEST_SIGNAL_LENGTH, &config, reconstructed);
+    double mse = calculate_mse(original_signal, reconstructed, TEST_SIGNAL_LENGTH);
+    ASSERT(mse < 10.0, "Reconstruction from the pyramid is accurate (MSE < 10.0)");
+}
+
+void test_feature_extraction() {
+    printf("\n--- Running test_feature_extraction ---\n");
+    int16_t pyramid[TEST_SIGNAL_LENGTH];
+    float features[WAVELET_FEATURE_VECTOR_LENGTH];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.decomposition_levels = 3;
+
+    int levels = wavelet_extract_features(original_signal, TEST_SIGNAL_LENGTH, &config, features);
+    wavelet_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, pyramid);
+
+    // Recompute energy and max magnitude of cD_1 from the stored pyramid.
+    const int16_t* d1 = pyramid + wavelet_band_offset(TEST_SIGNAL_LENGTH, 3, 1);
+    double energy = 0.0;
+    int max_abs = 0;
+    for (int i = 0; i < TEST_SIGNAL_LENGTH / 2; i++) {
+        energy += (double)d1[i] * d1[i];
+        if (abs(d1[i]) > max_abs) max_abs = abs(d1[i]);
+    }
+    ASSERT(levels == 3, "Feature extraction reports the effective number of levels");
+    ASSERT(features[WAVELET_FEATURE_ENERGY] == (float)energy &&
+           features[WAVELET_FEATURE_MAX_ABS] == (float)max_abs,
+           "Fused cD_1 features match the stored detail band");
+    ASSERT(features[3 * WAVELET_FEATURES_PER_BAND + WAVELET_FEATURE_ENERGY] == 0.0f,
+           "Features beyond the computed levels are zero");
+
+    int16_t channels[2 * TEST_SIGNAL_LENGTH];
+    float batch_features[2 * WAVELET_FEATURE_VECTOR_LENGTH];
+    memcpy(channels, original_signal, sizeof(original_signal));
+    memcpy(channels + TEST_SIGNAL_LENGTH, original_signal, sizeof(original_signal));
+    wavelet_extract_features_batch(channels, 2, TEST_SIGNAL_LENGTH, &config, batch_features);
+    ASSERT(memcmp(batch_features + WAVELET_FEATURE_VECTOR_LENGTH, features, sizeof(features)) == 0,
+           "Batched feature extraction matches the single-channel result");
+}
+
+void test_threshold_sweep() {
+    printf("\n--- Running test_threshold_sweep ---\n");
+    wavelet_threshold_t thresholds[3] = {
+        { THRESHOLD_HARD, 0 },
+        { THRESHOLD_HARD, 10000 },
+        { THRESHOLD_SOFT, 10000 }
+    };
+    static int16_t outputs[3 * TEST_SIGNAL_LENGTH];
+    wavelet_sweep_metrics_t metrics[3];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+
+    wavelet_filter_sweep(original_signal, TEST_SIGNAL_LENGTH, &config, thresholds, 3,
+                         outputs, original_signal, metrics);
+
+    int matches = 1;
+    for (int c = 0; c < 3; c++) {
+        memcpy(test_signal, original_signal, sizeof(original_signal));
+        config.threshold_type = thresholds[c].threshold_type;
+        config.threshold_value = thresholds[c].threshold_value;
+        wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+        matches &= memcmp(test_signal, outputs + c * TEST_SIGNAL_LENGTH, sizeof(test_signal)) == 0;
+    }
+    ASSERT(matches, "Each sweep output matches a separate wavelet_filter() call");
+    ASSERT(metrics[0].mse < 10.0 && metrics[1].mse > metrics[0].mse,
+           "Sweep reports MSE against the reference");
+}
+
+void test_incremental_update() {
+    printf("\n--- Running test_incremental_update ---\n");
+    static wavelet_incremental_t state;
+    int16_t patch[3] = { 500, -500, 500 };
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.wavelet = WAVELET_DB6;
+    config.threshold_value = 50;
+    config.decomposition_levels = 3;
+
+    wavelet_incremental_init(&state, original_signal, TEST_SIGNAL_LENGTH, &config);
+    memcpy(test_signal, original_signal, sizeof(original_signal));
+    wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+    ASSERT(memcmp(state.output, test_signal, sizeof(test_signal)) == 0,
+           "Incremental initialization matches wavelet_filter()");
+
+    // Edit near the start so the cones wrap around the periodic boundary.
+    int matches = 1;
+    uint16_t starts[2] = { 100, 1 };
+    memcpy(test_signal, original_signal, sizeof(original_signal));
+    for (int e = 0; e < 2; e++) {
+        wavelet_incremental_update(&state, starts[e], patch, 3);
+        memcpy(test_signal + starts[e], patch, sizeof(patch));
+        int16_t expected[TEST_SIGNAL_LENGTH];
+        memcpy(expected, test_signal, sizeof(expected));
+        wavelet_filter(expected, TEST_SIGNAL_LENGTH, &config);
+        matches &= memcmp(state.output, expected, sizeof(expected)) == 0;
+    }
+    ASSERT(matches, "Incremental updates match a full re-filter");
+    ASSERT(state.dirty_count < TEST_SIGNAL_LENGTH, "Incremental update refreshes only part of the output");
+}
+
+void test_spike_detection() {
+    printf("\n--- Running test_spike_detection ---\n");
+    wavelet_spike_event_t events[16];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.decomposition_levels = 1;
+    config.threshold_value = 400;
+
+    int count = wavelet_detect_spikes(original_signal, TEST_SIGNAL_LENGTH, &config, events, 16);
+    int found_large = 0, found_small = 0;
+    for (int i = 0; i < count; i++) {
+        if (events[i].index == TEST_SIGNAL_LENGTH / 4 && events[i].scale == 1) found_large = 1;
+        if (events[i].index == TEST_SIGNAL_LENGTH / 2 && events[i].scale == 1) found_small = 1;
+    }
+    ASSERT(count == 2 && found_large && found_small, "Both spikes are located in cD_1");
+
+    wavelet_spike_stream_t stream;
+    wavelet_spike_stream_init(&stream, &config);
+    int streamed = 0, matches = 1;
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i += 32) {
+        wavelet_spike_event_t chunk_events[4];
+        int n = wavelet_spike_stream_push(&stream, original_signal + i, 32, chunk_events, 4);
+        for (int e = 0; e < n; e++) {
+            matches &= chunk_events[e].index == events[streamed].index &&
+                       chunk_events[e].amplitude == events[streamed].amplitude;
+            streamed++;
+        }
+    }
+    ASSERT(streamed == count && matches, "Streaming detector reports the same events");
+}
+
+void test_spike_patching() {
+    printf("\n--- Running test_spike_patching ---\n");
+    int16_t pyramid[TEST_SIGNAL_LENGTH];
+    int16_t expected[TEST_SIGNAL_LENGTH];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.threshold_type = THRESHOLD_SPIKE;
+    config.threshold_value = 300;
+
+    // Reference: zero the outliers in the pyramid and reconstruct everything.
+    int levels = wavelet_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, pyramid);
+    uint16_t detail_start = wavelet_band_offset(TEST_SIGNAL_LENGTH, (uint8_t)levels, (uint8_t)levels);
+    apply_thresholding(pyramid + detail_start, TEST_SIGNAL_LENGTH - detail_start, &config);
+    wavelet_reconstruct(pyramid, TEST_SIGNAL_LENGTH, &config, expected);
+
+    memcpy(test_signal, original_signal, sizeof(original_signal));
+    wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+
+    int max_diff = 0;
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        int diff = abs(test_signal[i] - expected[i]);
+        if (diff > max_diff) max_diff = diff;
+    }
+    ASSERT(max_diff <= 4, "Sparse spike patching matches full reconstruction within rounding");
+    ASSERT(abs(test_signal[TEST_SIGNAL_LENGTH / 4] - original_signal[TEST_SIGNAL_LENGTH / 4 + 1]) < 400,
+           "Sparse spike patching suppresses the large spike");
+
+    // 100 samples over three levels leave the tail of the pyramid unused.
+    // The same thresholds given per level take the full reconstruction path.
+    enum { ODD_LENGTH = 100 };
+    int16_t odd_signal[ODD_LENGTH];
+    int16_t odd_expected[ODD_LENGTH];
+    for (int i = 0; i < ODD_LENGTH; i++) odd_signal[i] = (int16_t)(100.0 * sin(2 * PI * i / (double)ODD_LENGTH));
+    odd_signal[37] += 3000;
+    memcpy(odd_expected, odd_signal, sizeof(odd_signal));
+    config.decomposition_levels = 3;
+    config.threshold_value = 1000;
+    wavelet_config_t reference = config;
+    reference.per_level_thresholds = 1;
+    for (int band = 1; band <= 3; band++) {
+        reference.level_threshold[band].threshold_type = THRESHOLD_SPIKE;
+        reference.level_threshold[band].threshold_value = config.threshold_value;
+    }
+    wavelet_filter(odd_expected, ODD_LENGTH, &reference);
+
+    wavelet_filter(odd_signal, ODD_LENGTH, &config);
+    ASSERT(memcmp(odd_signal, odd_expected, sizeof(odd_signal)) == 0,
+           "Sparse spike patching handles lengths that are not a multiple of 2^levels");
+}
+
+void test_band_modes() {
+    printf("\n--- Running test_band_modes ---\n");
+    int16_t pyramid[TEST_SIGNAL_LENGTH];
+    int16_t expected[TEST_SIGNAL_LENGTH];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.decomposition_levels = 4;
+    config.band_mode[0] = WAVELET_BAND_ZERO;  // Drop cA_4
+    config.band_mode[4] = WAVELET_BAND_ZERO;  // Drop cD_4
+    config.band_mode[3] = WAVELET_BAND_SCALE; // Halve cD_3
+    config.band_gain[3] = 1 << 13;
+    config.band_mode[1] = WAVELET_BAND_KEEP;  // Keep cD_1 untouched
+
+    // Reference: full decomposition, band edits by hand, full reconstruction.
+    wavelet_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, pyramid);
+    memset(pyramid, 0, 2 * (TEST_SIGNAL_LENGTH / 16) * sizeof(int16_t));
+    int16_t* d3 = pyramid + wavelet_band_offset(TEST_SIGNAL_LENGTH, 4, 3);
+    for (int i = 0; i < TEST_SIGNAL_LENGTH / 8; i++) {
+        d3[i] = (int16_t)((d3[i] * 8192 + 8192) >> 14);
+    }
+    apply_thresholding(pyramid + wavelet_band_offset(TEST_SIGNAL_LENGTH, 4, 2), TEST_SIGNAL_LENGTH / 4, &config);
+    wavelet_reconstruct(pyramid, TEST_SIGNAL_LENGTH, &config, expected);
+
+    memcpy(test_signal, original_signal, sizeof(original_signal));
+    wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+    ASSERT(memcmp(test_signal, expected, sizeof(expected)) == 0,
+           "Band mask matches manual per-band processing");
+
+    // Band-stop everything but cD_1: a pure high-pass.
+    wavelet_get_default_config(&config);
+    config.decomposition_levels = 4;
+    config.threshold_type = THRESHOLD_ZERO;
+    config.band_mode[0] = WAVELET_BAND_ZERO;
+    config.band_mode[1] = WAVELET_BAND_KEEP;
+    memcpy(test_signal, original_signal, sizeof(original_signal));
+    wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+    int16_t approx1[TEST_SIGNAL_LENGTH / 2];
+    int16_t detail1[TEST_SIGNAL_LENGTH / 2];
+    dwt(original_signal, approx1, detail1, TEST_SIGNAL_LENGTH, config.wavelet, config.q_format);
+    memset(approx1, 0, sizeof(approx1));
+    idwt(approx1, detail1, expected, TEST_SIGNAL_LENGTH / 2, config.wavelet, config.q_format);
+    ASSERT(memcmp(test_signal, expected, sizeof(expected)) == 0,
+           "Zeroed bands are skipped without changing the result");
+}
+
+void test_per_level_thresholds() {
+    printf("\n--- Running test_per_level_thresholds ---\n");
+    int16_t pyramid[TEST_SIGNAL_LENGTH];
+    int16_t expected[TEST_SIGNAL_LENGTH];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.decomposition_levels = 3;
+    config.per_level_thresholds = 1;
+    config.level_threshold[1].threshold_type = THRESHOLD_HARD;
+    config.level_threshold[1].threshold_value = 400;
+    config.level_threshold[2].threshold_type = THRESHOLD_SOFT;
+    config.level_threshold[2].threshold_value = 50;
+    config.level_threshold[3].threshold_type = THRESHOLD_HARD;
+    config.level_threshold[3].threshold_value = 0;
+
+    wavelet_config_t level_config = config;
+    level_config.per_level_thresholds = 0;
+    wavelet_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, pyramid);
+    for (uint8_t k = 1; k <= 3; k++) {
+        level_config.threshold_type = config.level_threshold[k].threshold_type;
+        level_config.threshold_value = config.level_threshold[k].threshold_value;
+        apply_thresholding(pyramid + wavelet_band_offset(TEST_SIGNAL_LENGTH, 3, k),
+                           wavelet_band_length(TEST_SIGNAL_LENGTH, 3, k), &level_config);
+    }
+    wavelet_reconstruct(pyramid, TEST_SIGNAL_LENGTH, &config, expected);
+
+    memcpy(test_signal, original_signal, sizeof(original_signal));
+    wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+    ASSERT(memcmp(test_signal, expected, sizeof(expected)) == 0,
+           "Per-level thresholds are applied to their own bands");
+}
+
+void test_block_thresholding() {
+    printf("\n--- Running test_block_thresholding ---\n");
+    int16_t coeffs[64];
+    int16_t expected[64];
+    for (int i = 0; i < 64; i++) {
+        coeffs[i] = (int16_t)(((i * 37) % 23) - 11);
+    }
+    coeffs[20] = 90;
+    coeffs[63] = -80; // Neighbourhood wraps around to coeffs[0]
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.threshold_type = THRESHOLD_BLOCK;
+    config.threshold_value = 30;
+    config.neighbourhood_radius = 2;
+
+    // Brute force: mean energy over the wrapped 5-coefficient neighbourhood.
+    for (int i = 0; i < 64; i++) {
+        long energy = 0;
+        for (int j = -2; j <= 2; j++) {
+            int v = coeffs[(i + j + 64) % 64];
+            energy += v * v;
+        }
+        expected[i] = (energy >= 30L * 30 * 5) ? coeffs[i] : 0;
+    }
+    apply_thresholding(coeffs, 64, &config);
+    ASSERT(memcmp(coeffs, expected, sizeof(expected)) == 0,
+           "Block thresholding keeps only high-energy neighbourhoods");
+    ASSERT(coeffs[19] != 0 && coeffs[0] != 0 && coeffs[40] == 0,
+           "Neighbours of a strong coefficient survive");
+
+    static wavelet_incremental_t state;
+    int16_t patch[2] = { 900, -900 };
+    config.threshold_type = THRESHOLD_BLOCK_JS;
+    config.decomposition_levels = 3;
+    wavelet_incremental_init(&state, original_signal, TEST_SIGNAL_LENGTH, &config);
+    wavelet_incremental_update(&state, 150, patch, 2);
+    memcpy(test_signal, original_signal, sizeof(original_signal));
+    memcpy(test_signal + 150, patch, sizeof(patch));
+    wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+    ASSERT(memcmp(state.output, test_signal, sizeof(test_signal)) == 0,
+           "Incremental update honours neighbourhood thresholding");
+}
+
+void test_adaptive_threshold() {
+    printf("\n--- Running test_adaptive_threshold ---\n");
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.decomposition_levels = 3;
+
+    wavelet_stream_t stream;
+    wavelet_stream_init(&stream, &config, 64);
+    wavelet_stream_set_adaptive(&stream, 0.99f, 3.0f, 0.2f);
+
+    // Pseudo-random noise whose amplitude quadruples halfway through.
+    int16_t frame[64];
+    uint32_t seed = 12345;
+    int16_t quiet_threshold = 0;
+    for (int f = 0; f < 80; f++) {
+        int amplitude = (f < 40) ? 20 : 80;
+        for (int i = 0; i < 64; i++) {
+            seed = seed * 1103515245u + 12345u;
+            frame[i] = (int16_t)((int)((seed >> 16) % (2 * amplitude + 1)) - amplitude);
+        }
+        wavelet_stream_process(&stream, frame);
+        if (f == 39) quiet_threshold = stream.config.threshold_value;
+    }
+    int16_t loud_threshold = stream.config.threshold_value;
+    ASSERT(quiet_threshold > 0 && loud_threshold > 3 * quiet_threshold && loud_threshold < 5 * quiet_threshold,
+           "Adaptive threshold follows the noise floor");
+
+    // Per-level thresholds pick up the tracked value too.
+    config.per_level_thresholds = 1;
+    config.level_threshold[2].threshold_type = THRESHOLD_SOFT;
+    wavelet_stream_init(&stream, &config, 64);
+    wavelet_stream_set_adaptive(&stream, 0.99f, 3.0f, 0.2f);
+    for (int f = 0; f < 40; f++) {
+        for (int i = 0; i < 64; i++) {
+            seed = seed * 1103515245u + 12345u;
+            frame[i] = (int16_t)((int)((seed >> 16) % 161) - 80);
+        }
+        wavelet_stream_process(&stream, frame);
+    }
+    int follows = stream.config.threshold_value != config.threshold_value;
+    for (int band = 1; band <= 3; band++) {
+        follows &= stream.config.level_threshold[band].threshold_value == stream.config.threshold_value;
+    }
+    ASSERT(follows && stream.config.level_threshold[2].threshold_type == THRESHOLD_SOFT,
+           "Adaptive threshold drives the per-level thresholds");
+}
+
+void test_wavelet_families() {
+    printf("\n--- Running test_wavelet_families ---\n");
+    int16_t pyramid[TEST_SIGNAL_LENGTH];
+    int16_t reconstructed[TEST_SIGNAL_LENGTH];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.decomposition_levels = 3;
+
+    // Every generated bank must reconstruct perfectly up to Q14 rounding.
+    double worst_mse = 0.0;
+    for (int w = WAVELET_DAUBECHIES_2; w <= WAVELET_COIFLET_5; w++) {
+        config.wavelet = (wavelet_type_t)w;
+        wavelet_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, pyramid);
+        wavelet_reconstruct(pyramid, TEST_SIGNAL_LENGTH, &config, reconstructed);
+        double mse = calculate_mse(original_signal, reconstructed, TEST_SIGNAL_LENGTH);
+        if (mse > worst_mse) worst_mse = mse;
+    }
+    ASSERT(worst_mse < 10.0, "Every db/sym/coif bank reconstructs accurately (MSE < 10.0)");
+
+    int16_t approx_a[TEST_SIGNAL_LENGTH / 2], detail_a[TEST_SIGNAL_LENGTH / 2];
+    int16_t approx_b[TEST_SIGNAL_LENGTH / 2], detail_b[TEST_SIGNAL_LENGTH / 2];
+    dwt(original_signal, approx_a, detail_a, TEST_SIGNAL_LENGTH, WAVELET_DB4, 14);
+    dwt(original_signal, approx_b, detail_b, TEST_SIGNAL_LENGTH, WAVELET_DAUBECHIES_2, 14);
+    ASSERT(memcmp(approx_a, approx_b, sizeof(approx_a)) == 0 && memcmp(detail_a, detail_b, sizeof(detail_a)) == 0,
+           "WAVELET_DAUBECHIES_2 is the 4-tap WAVELET_DB4 filter");
+
+    // Long kernels cap the usable depth: coif5 has 30 taps.
+    config.wavelet = WAVELET_COIFLET_5;
+    config.decomposition_levels = 8;
+    ASSERT(wavelet_levels_for_length(TEST_SIGNAL_LENGTH, &config) == 4,
+           "Decomposition depth is limited by the kernel length");
+}
+
+// Low-pass filter of a two-channel lattice with rotations alternating
+// between +angle and -angle, quantized to Q14 with the DC gain kept at
+// sqrt(2). The result is orthonormal for any angle, while its absolute tap
+// sum grows with the angle.
+static void lattice_lowpass(double angle, uint8_t len, int16_t* taps) {
+    double even[MAX_WAVELET_KERNEL_LENGTH / 2] = { 0 };
+    double odd[MAX_WAVELET_KERNEL_LENGTH / 2] = { 0 };
+    uint8_t stages = len / 2;
+    even[0] = cos(PI / 4 - angle);
+    odd[0] = sin(PI / 4 - angle);
+    for (uint8_t k = 1; k < stages; k++) {
+        for (uint8_t t = k; t > 0; t--) odd[t] = odd[t - 1];
+        odd[0] = 0.0;
+        double c = cos((k & 1) ? angle : -angle);
+        double s = sin((k & 1) ? angle : -angle);
+        for (uint8_t t = 0; t <= k; t++) {
+            double e = even[t];
+            even[t] = c * e - s * odd[t];
+            odd[t] = s * e + c * odd[t];
+        }
+    }
+    int32_t dc = 0;
+    uint8_t largest = 0;
+    for (uint8_t k = 0; k < len; k++) {
+        double tap = (k & 1) ? odd[k / 2] : even[k / 2];
+        taps[k] = (int16_t)lround(tap * 16384.0);
+        dc += taps[k];
+        if (abs(taps[k]) > abs(taps[largest])) largest = k;
+    }
+    taps[largest] += (int16_t)(23170 - dc);
+}
+
+void test_custom_wavelet() {
+    printf("\n--- Running test_custom_wavelet ---\n");
+    // db4 low-pass taps in Q15; must behave exactly like the built-in table.
+    const int16_t db4_q15[] = { 15826, 27410, 7344, -4240 };
+    const int16_t not_orthogonal[] = { 8192, 8192, 8192, 8192 };
+
+    wavelet_type_t custom = wavelet_register_custom(db4_q15, 4, 15);
+    ASSERT(custom >= WAVELET_CUSTOM_FIRST, "Orthogonal custom filter is registered");
+    ASSERT(wavelet_register_custom(not_orthogonal, 4, 14) == WAVELET_INVALID,
+           "Non-orthogonal filter is rejected");
+
+    // Both 64-tap lattices are orthonormal; the second has an absolute tap
+    // sum above 4, so a full-scale input would overflow the accumulator.
+    int16_t narrow[MAX_WAVELET_KERNEL_LENGTH];
+    int16_t wide[MAX_WAVELET_KERNEL_LENGTH];
+    lattice_lowpass(0.05, MAX_WAVELET_KERNEL_LENGTH, narrow);
+    lattice_lowpass(0.5, MAX_WAVELET_KERNEL_LENGTH, wide);
+    ASSERT(wavelet_register_custom(narrow, MAX_WAVELET_KERNEL_LENGTH, 14) >= WAVELET_CUSTOM_FIRST,
+           "Long custom filter within accumulator headroom is registered");
+    ASSERT(wavelet_register_custom(wide, MAX_WAVELET_KERNEL_LENGTH, 14) == WAVELET_INVALID,
+           "Custom filter that can overflow the accumulator is rejected");
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    memcpy(test_signal, original_signal, sizeof(original_signal));
+    wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+
+    int16_t custom_signal[TEST_SIGNAL_LENGTH];
+    memcpy(custom_signal, original_signal, sizeof(original_signal));
+    config.wavelet = custom;
+    wavelet_filter(custom_signal, TEST_SIGNAL_LENGTH, &config);
+    ASSERT(memcmp(custom_signal, test_signal, sizeof(test_signal)) == 0,
+           "Custom filter bank matches the equivalent built-in wavelet");
+}
+
+void test_cwt_scalogram() {
+    printf("\n--- Running test_cwt_scalogram ---\n");
+    enum { SCALES = 21 };
+    static float scalogram[SCALES * TEST_SIGNAL_LENGTH];
+    static float threaded[SCALES * TEST_SIGNAL_LENGTH];
+    float scales[SCALES];
+    int16_t tone[TEST_SIGNAL_LENGTH];
+
+    // Quarter-octave scales from 4 to 128 samples; a tone with a 32-sample period.
+    for (int s = 0; s < SCALES; s++) scales[s] = 4.0f * powf(2.0f, s / 4.0f);
+    for (int t = 0; t < TEST_SIGNAL_LENGTH; t++) tone[t] = (int16_t)(1000.0 * sin(2.0 * PI * t / 32.0));
+
+    // Scale at which each family's response to the tone peaks: sw = omega0,
+    // sqrt(2.5) and m + 1/2 respectively, with w = 2 pi / 32.
+    const wavelet_cwt_family_t families[] = { WAVELET_CWT_MORLET, WAVELET_CWT_MEXICAN_HAT, WAVELET_CWT_PAUL };
+    const double expected_scale[] = { 6.0 * 32.0 / (2.0 * PI), 1.5811 * 32.0 / (2.0 * PI), 4.5 * 32.0 / (2.0 * PI) };
+    int peaks_ok = 1;
+    for (int f = 0; f < 3; f++) {
+        wavelet_cwt_config_t config = { families[f], 0.0f, 1 };
+        if (wavelet_cwt(tone, TEST_SIGNAL_LENGTH, scales, SCALES, &config, scalogram) != 0) {
+            peaks_ok = 0;
+            continue;
+        }
+        int peak = 0;
+        for (int s = 1; s < SCALES; s++) {
+            if (scalogram[s * TEST_SIGNAL_LENGTH + 100] > scalogram[peak * TEST_SIGNAL_LENGTH + 100]) peak = s;
+        }
+        // Within one quarter-octave step of the analytic peak.
+        if (fabs(log2(scales[peak] / expected_scale[f])) > 0.25) peaks_ok = 0;
+    }
+    ASSERT(peaks_ok, "Scalogram peaks at the scale matching the tone for every family");
+
+    wavelet_cwt_config_t config = { WAVELET_CWT_MORLET, 0.0f, 1 };
+    wavelet_cwt(original_signal, TEST_SIGNAL_LENGTH, scales, SCALES, &config, scalogram);
+    config.num_threads = 4;
+    wavelet_cwt(original_signal, TEST_SIGNAL_LENGTH, scales, SCALES, &config, threaded);
+    ASSERT(memcmp(scalogram, threaded, sizeof(threaded)) == 0, "Threaded scalogram matches the single-threaded one");
+
+    scales[3] = 0.0f;
+    ASSERT(wavelet_cwt(original_signal, TEST_SIGNAL_LENGTH, scales, SCALES, &config, threaded) == -1,
+           "Non-positive scales are rejected");
+}
+
+void test_dual_tree() {
+    printf("\n--- Running test_dual_tree ---\n");
+    static int16_t pyramid[2 * TEST_SIGNAL_LENGTH];
+    int16_t reconstructed[TEST_SIGNAL_LENGTH];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.wavelet = WAVELET_DAUBECHIES_4;
+    config.decomposition_levels = 4;
+
+    int levels = wavelet_dtcwt_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, pyramid);
+    wavelet_dtcwt_reconstruct(pyramid, TEST_SIGNAL_LENGTH, &config, reconstructed);
+    ASSERT(levels == 4 && calculate_mse(original_signal, reconstructed, TEST_SIGNAL_LENGTH) < 10.0,
+           "Dual-tree reconstruction is accurate (MSE < 10.0)");
+
+    // Energy of cD_2 for an impulse at every position modulo 8. The real
+    // DWT's band energy swings with the position; the magnitudes of the
+    // dual tree should swing much less.
+    double dwt_min = 1e300, dwt_max = 0.0, dt_min = 1e300, dt_max = 0.0;
+    static int16_t real_pyramid[TEST_SIGNAL_LENGTH];
+    int16_t impulse[TEST_SIGNAL_LENGTH];
+    uint16_t offset = wavelet_band_offset(TEST_SIGNAL_LENGTH, 4, 2);
+    for (int shift = 0; shift < 8; shift++) {
+        memset(impulse, 0, sizeof(impulse));
+        impulse[120 + shift] = 8000;
+        wavelet_decompose(impulse, TEST_SIGNAL_LENGTH, &config, real_pyramid);
+        wavelet_dtcwt_decompose(impulse, TEST_SIGNAL_LENGTH, &config, pyramid);
+        double real_energy = 0.0, complex_energy = 0.0;
+        for (int i = 0; i < TEST_SIGNAL_LENGTH / 4; i++) {
+            double a = pyramid[2 * (offset + i)], b = pyramid[2 * (offset + i) + 1];
+            real_energy += 2.0 * real_pyramid[offset + i] * real_pyramid[offset + i];
+            complex_energy += a * a + b * b;
+        }
+        if (real_energy < dwt_min) dwt_min = real_energy;
+        if (real_energy > dwt_max) dwt_max = real_energy;
+        if (complex_energy < dt_min) dt_min = complex_energy;
+        if (complex_energy > dt_max) dt_max = complex_energy;
+    }
+    ASSERT(dt_max / dt_min < dwt_max / dwt_min, "Dual-tree band energy varies less with shifts than the DWT");
+
+    // Denoising on magnitudes: a noisy tone gets closer to the clean tone.
+    int16_t clean[TEST_SIGNAL_LENGTH], noisy[TEST_SIGNAL_LENGTH];
+    srand(7);
+    for (int t = 0; t < TEST_SIGNAL_LENGTH; t++) {
+        clean[t] = (int16_t)(2000.0 * sin(2.0 * PI * t / 64.0));
+        noisy[t] = (int16_t)(clean[t] + (rand() % 401) - 200);
+    }
+    memcpy(test_signal, noisy, sizeof(noisy));
+    config.threshold_type = THRESHOLD_SOFT;
+    config.threshold_value = 250;
+    wavelet_dtcwt_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+    ASSERT(calculate_mse(clean, test_signal, TEST_SIGNAL_LENGTH) < calculate_mse(clean, noisy, TEST_SIGNAL_LENGTH),
+           "Magnitude thresholding reduces the noise");
+
+    // Near full scale |A + iB| exceeds INT16_MAX; soft thresholding must
+    // still shrink every magnitude by exactly the threshold.
+    int16_t loud[TEST_SIGNAL_LENGTH], expected[TEST_SIGNAL_LENGTH];
+    for (int t = 0; t < TEST_SIGNAL_LENGTH; t++) {
+        loud[t] = (int16_t)(((t & 1) ? 20000 : -20000) + 3000.0 * sin(2.0 * PI * t / 32.0));
+    }
+    config.decomposition_levels = 2;
+    for (int band = 0; band <= 2; band++) config.band_mode[band] = WAVELET_BAND_KEEP;
+    config.band_mode[1] = WAVELET_BAND_THRESHOLD;
+    config.threshold_value = 1000;
+    wavelet_dtcwt_decompose(loud, TEST_SIGNAL_LENGTH, &config, pyramid);
+    int16_t* d1 = pyramid + 2 * wavelet_band_offset(TEST_SIGNAL_LENGTH, 2, 1);
+    double loudest = 0.0;
+    for (int i = 0; i < TEST_SIGNAL_LENGTH / 2; i++) {
+        double magnitude = sqrt((double)d1[2 * i] * d1[2 * i] + (double)d1[2 * i + 1] * d1[2 * i + 1]);
+        double gain = (magnitude > 1000.0) ? (magnitude - 1000.0) / magnitude : 0.0;
+        if (magnitude > loudest) loudest = magnitude;
+        d1[2 * i] = (int16_t)lround(d1[2 * i] * gain);
+        d1[2 * i + 1] = (int16_t)lround(d1[2 * i + 1] * gain);
+    }
+    wavelet_dtcwt_reconstruct(pyramid, TEST_SIGNAL_LENGTH, &config, expected);
+    memcpy(test_signal, loud, sizeof(loud));
+    wavelet_dtcwt_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+    int max_diff = 0;
+    for (int t = 0; t < TEST_SIGNAL_LENGTH; t++) {
+        int diff = abs(test_signal[t] - expected[t]);
+        if (diff > max_diff) max_diff = diff;
+    }
+    ASSERT(loudest > INT16_MAX && max_diff <= 2, "Magnitude thresholding is exact beyond INT16_MAX");
+}
+
+void test_haar_engine() {
+    printf("\n--- Running test_haar_engine ---\n");
+    // A custom bank with the Haar taps runs through the generic kernels.
+    const int16_t haar_taps[] = { 11585, 11585 };
+    wavelet_type_t generic_haar = wavelet_register_custom(haar_taps, 2, 14);
+    int16_t fused_pyramid[TEST_SIGNAL_LENGTH], generic_pyramid[TEST_SIGNAL_LENGTH];
+    int16_t fused_signal[TEST_SIGNAL_LENGTH], generic_signal[TEST_SIGNAL_LENGTH];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.decomposition_levels = 5;
+    config.band_mode[3] = WAVELET_BAND_ZERO;
+
+    config.wavelet = WAVELET_HAAR;
+    wavelet_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, fused_pyramid);
+    memcpy(fused_signal, original_signal, sizeof(original_signal));
+    wavelet_filter(fused_signal, TEST_SIGNAL_LENGTH, &config);
+
+    config.wavelet = generic_haar;
+    wavelet_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, generic_pyramid);
+    memcpy(generic_signal, original_signal, sizeof(original_signal));
+    wavelet_filter(generic_signal, TEST_SIGNAL_LENGTH, &config);
+
+    ASSERT(memcmp(fused_pyramid, generic_pyramid, sizeof(fused_pyramid)) == 0,
+           "Fused Haar decomposition matches the generic kernels");
+    ASSERT(memcmp(fused_signal, generic_signal, sizeof(fused_signal)) == 0,
+           "Fused Haar filtering matches the generic kernels");
+
+    // The S-transform is lossless, even at full scale.
+    int32_t s_pyramid[TEST_SIGNAL_LENGTH];
+    int16_t extremes[TEST_SIGNAL_LENGTH];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) extremes[i] = (i & 1) ? INT16_MAX : INT16_MIN;
+    config.decomposition_levels = 8;
+    int levels = wavelet_haar_s_decompose(extremes, TEST_SIGNAL_LENGTH, &config, s_pyramid);
+    wavelet_haar_s_reconstruct(s_pyramid, TEST_SIGNAL_LENGTH, &config, test_signal);
+    ASSERT(levels == 8 && memcmp(extremes, test_signal, sizeof(extremes)) == 0,
+           "S-transform reconstructs full-scale input exactly");
+    ASSERT(s_pyramid[wavelet_band_offset(TEST_SIGNAL_LENGTH, 8, 1) + 1] == INT16_MIN - INT16_MAX,
+           "S-transform keeps 17-bit differences");
+
+    wavelet_haar_s_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, s_pyramid);
+    wavelet_haar_s_reconstruct(s_pyramid, TEST_SIGNAL_LENGTH, &config, test_signal);
+    ASSERT(memcmp(original_signal, test_signal, sizeof(test_signal)) == 0,
+           "S-transform reconstructs the test signal exactly");
+}
+
+void test_inplace_transform() {
+    printf("\n--- Running test_inplace_transform ---\n");
+    const wavelet_type_t wavelets[] = { WAVELET_HAAR, WAVELET_DB4, WAVELET_DB6, WAVELET_COIFLET_3 };
+    int16_t pyramid[TEST_SIGNAL_LENGTH], inplace[TEST_SIGNAL_LENGTH], reconstructed[TEST_SIGNAL_LENGTH];
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.decomposition_levels = 5;
+
+    int decompose_ok = 1, reconstruct_ok = 1, filter_ok = 1;
+    for (size_t w = 0; w < sizeof(wavelets) / sizeof(wavelets[0]); w++) {
+        config.wavelet = wavelets[w];
+        wavelet_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, pyramid);
+        memcpy(inplace, original_signal, sizeof(original_signal));
+        wavelet_decompose_inplace(inplace, TEST_SIGNAL_LENGTH, &config);
+        decompose_ok &= memcmp(pyramid, inplace, sizeof(pyramid)) == 0;
+
+        wavelet_reconstruct(pyramid, TEST_SIGNAL_LENGTH, &config, reconstructed);
+        wavelet_reconstruct_inplace(inplace, TEST_SIGNAL_LENGTH, &config);
+        reconstruct_ok &= memcmp(reconstructed, inplace, sizeof(inplace)) == 0;
+
+        memcpy(test_signal, original_signal, sizeof(original_signal));
+        memcpy(inplace, original_signal, sizeof(original_signal));
+        wavelet_filter(test_signal, TEST_SIGNAL_LENGTH, &config);
+        wavelet_filter_inplace(inplace, TEST_SIGNAL_LENGTH, &config);
+        filter_ok &= memcmp(test_signal, inplace, sizeof(inplace)) == 0;
+    }
+    ASSERT(decompose_ok, "In-place decomposition matches wavelet_decompose()");
+    ASSERT(reconstruct_ok, "In-place reconstruction matches wavelet_reconstruct()");
+    ASSERT(filter_ok, "In-place filtering matches wavelet_filter()");
+
+    // Lengths beyond MAX_SIGNAL_LENGTH need no extra buffers.
+    enum { LONG_LENGTH = 4 * TEST_SIGNAL_LENGTH };
+    static int16_t long_signal[LONG_LENGTH], long_original[LONG_LENGTH];
+    for (int i = 0; i < LONG_LENGTH; i++) long_original[i] = original_signal[i % TEST_SIGNAL_LENGTH];
+    memcpy(long_signal, long_original, sizeof(long_original));
+    config.wavelet = WAVELET_DB6;
+    wavelet_decompose_inplace(long_signal, LONG_LENGTH, &config);
+    wavelet_reconstruct_inplace(long_signal, LONG_LENGTH, &config);
+    ASSERT(calculate_mse(long_original, long_signal, LONG_LENGTH) < 10.0,
+           "In-place round trip on a long signal is accurate (MSE < 10.0)");
+}
+
+void test_blocked_cascade() {
+    printf("\n--- Running test_blocked_cascade ---\n");
+    const wavelet_type_t wavelets[] = { WAVELET_HAAR, WAVELET_DB6, WAVELET_COIFLET_3, WAVELET_DAUBECHIES_20 };
+    enum { LONG_LENGTH = 24576 }; // Several blocks, not a power of two
+    static int16_t signal[LONG_LENGTH], reference[LONG_LENGTH], blocked[LONG_LENGTH], output[LONG_LENGTH];
+    for (int i = 0; i < LONG_LENGTH; i++) {
+        signal[i] = (int16_t)(3000.0 * sin(2.0 * PI * i / 700.0) + original_signal[i % TEST_SIGNAL_LENGTH] / 4);
+    }
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.decomposition_levels = 6;
+
+    int decompose_ok = 1, reconstruct_ok = 1;
+    for (size_t w = 0; w < sizeof(wavelets) / sizeof(wavelets[0]); w++) {
+        config.wavelet = wavelets[w];
+        memcpy(reference, signal, sizeof(signal));
+        wavelet_decompose_inplace(reference, LONG_LENGTH, &config);
+        decompose_ok &= wavelet_decompose_blocked(signal, LONG_LENGTH, &config, blocked) == 6;
+        decompose_ok &= memcmp(reference, blocked, sizeof(blocked)) == 0;
+
+        wavelet_reconstruct_inplace(reference, LONG_LENGTH, &config);
+        reconstruct_ok &= wavelet_reconstruct_blocked(blocked, LONG_LENGTH, &config, output) == 6;
+        reconstruct_ok &= memcmp(reference, output, sizeof(output)) == 0;
+    }
+    ASSERT(decompose_ok, "Blocked decomposition matches the single-pass transform");
+    ASSERT(reconstruct_ok, "Blocked reconstruction matches the single-pass transform");
+
+    // Short signals wrap the tail cone around the whole period.
+    config.wavelet = WAVELET_DB6;
+    int16_t pyramid[TEST_SIGNAL_LENGTH], short_blocked[TEST_SIGNAL_LENGTH];
+    wavelet_decompose(original_signal, TEST_SIGNAL_LENGTH, &config, pyramid);
+    wavelet_decompose_blocked(original_signal, TEST_SIGNAL_LENGTH, &config, short_blocked);
+    ASSERT(memcmp(pyramid, short_blocked, sizeof(pyramid)) == 0, "Blocked decomposition matches on short signals");
+    int16_t short_reference[TEST_SIGNAL_LENGTH], short_output[TEST_SIGNAL_LENGTH];
+    wavelet_reconstruct(pyramid, TEST_SIGNAL_LENGTH, &config, short_reference);
+    wavelet_reconstruct_blocked(pyramid, TEST_SIGNAL_LENGTH, &config, short_output);
+    ASSERT(memcmp(short_reference, short_output, sizeof(short_output)) == 0, "Blocked reconstruction matches on short signals");
+}
+
+void test_long_filter() {
+    printf("\n--- Running test_long_filter ---\n");
+    enum { LONG_LENGTH = 19999, PAD = 4096 }; // Odd length; PAD is a multiple of 2^levels beyond the margin
+    static int16_t signal[LONG_LENGTH], output[LONG_LENGTH], extended[PAD + LONG_LENGTH + 1 + PAD];
+    for (int i = 0; i < LONG_LENGTH; i++) {
+        signal[i] = (int16_t)(2000.0 * sin(2.0 * PI * i / 900.0) + ((i * 7919) % 601) - 300);
+    }
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.wavelet = WAVELET_SYMLET_8;
+    config.decomposition_levels = 5;
+    config.threshold_type = THRESHOLD_SOFT;
+    config.threshold_value = 150;
+
+    const wavelet_extension_t extensions[] = { WAVELET_EXTEND_ZERO, WAVELET_EXTEND_SYMMETRIC };
+    int matches = 1, status_ok = 1;
+    for (int e = 0; e < 2; e++) {
+        // Reference: one periodic transform over the extended signal.
+        int extended_len = (int)(sizeof(extended) / sizeof(extended[0]));
+        for (int t = 0; t < extended_len; t++) {
+            int p = t - PAD;
+            if (p < 0) p = (extensions[e] == WAVELET_EXTEND_ZERO) ? -1 : -1 - p;
+            else if (p >= LONG_LENGTH) p = (extensions[e] == WAVELET_EXTEND_ZERO) ? -1 : 2 * LONG_LENGTH - 1 - p;
+            extended[t] = (p < 0) ? 0 : signal[p];
+        }
+        wavelet_filter_inplace(extended, (uint16_t)extended_len, &config);
+
+        const uint32_t blocks[] = { 0, 512, 3000 };
+        for (int b = 0; b < 3; b++) {
+            wavelet_long_config_t long_config = { extensions[e], (uint8_t)(1 + 2 * b), blocks[b] };
+            memset(output, 0, sizeof(output));
+            status_ok &= wavelet_filter_long(signal, LONG_LENGTH, &config, &long_config, output) == 0;
+            matches &= memcmp(output, extended + PAD, sizeof(output)) == 0;
+        }
+    }
+    ASSERT(status_ok, "Long filter accepts block and thread counts");
+    ASSERT(matches, "Long filter seams match the non-blocked transform for both extensions");
+
+    // A 64-tap bank takes the FFT convolution path inside the windows; the
+    // in-place reference runs the direct loops.
+    int16_t taps[MAX_WAVELET_KERNEL_LENGTH];
+    lattice_lowpass(0.05, MAX_WAVELET_KERNEL_LENGTH, taps);
+    config.wavelet = wavelet_register_custom(taps, MAX_WAVELET_KERNEL_LENGTH, 14);
+    config.decomposition_levels = 2;
+    int extended_len = (int)(sizeof(extended) / sizeof(extended[0]));
+    for (int t = 0; t < extended_len; t++) {
+        int p = t - PAD;
+        if (p < 0) p = -1 - p;
+        else if (p >= LONG_LENGTH) p = 2 * LONG_LENGTH - 1 - p;
+        extended[t] = signal[p];
+    }
+    wavelet_filter_inplace(extended, (uint16_t)extended_len, &config);
+    wavelet_long_config_t fft_config = { WAVELET_EXTEND_SYMMETRIC, 2, 3000 };
+    status_ok = wavelet_filter_long(signal, LONG_LENGTH, &config, &fft_config, output) == 0;
+    ASSERT(status_ok && memcmp(output, extended + PAD, sizeof(output)) == 0,
+           "Long filter with FFT convolution matches the direct loops bit for bit");
+
+    wavelet_long_config_t bad_config = { WAVELET_EXTEND_ZERO, 1, 0 };
+    config.neighbourhood_radius = 255;
+    config.decomposition_levels = 8;
+    ASSERT(wavelet_filter_long(signal, LONG_LENGTH, &config, &bad_config, output) == -1,
+           "Long filter rejects margins beyond a 16-bit window");
+}
+
+void test_decimator() {
+    printf("\n--- Running test_decimator ---\n");
+    enum { LONG_LENGTH = 6144, LEVELS = 3 };
+    static int16_t signal[LONG_LENGTH], pyramid[LONG_LENGTH], zeroed[LONG_LENGTH];
+    static int16_t reference[LONG_LENGTH], upsampled[LONG_LENGTH], decimated[LONG_LENGTH >> LEVELS];
+    for (int i = 0; i < LONG_LENGTH; i++) {
+        signal[i] = (int16_t)(4000.0 * sin(2.0 * PI * i / 640.0) + 500.0 * sin(2.0 * PI * i / 3.0));
+    }
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.wavelet = WAVELET_SYMLET_6;
+    config.decomposition_levels = LEVELS;
+
+    int levels = wavelet_decimate(signal, LONG_LENGTH, &config, decimated);
+    wavelet_decompose_blocked(signal, LONG_LENGTH, &config, pyramid);
+    ASSERT(levels == LEVELS && memcmp(decimated, pyramid, sizeof(decimated)) == 0,
+           "Decimation equals the final approximation band");
+
+    // A tone above the new Nyquist rate is strongly attenuated, one well
+    // below it passes with the orthonormal gain of 2^(3/2).
+    static int16_t tone[LONG_LENGTH], tone_decimated[LONG_LENGTH >> LEVELS];
+    double rms[2];
+    const double periods[2] = { 3.0, 640.0 };
+    for (int p = 0; p < 2; p++) {
+        for (int i = 0; i < LONG_LENGTH; i++) tone[i] = (int16_t)(1000.0 * sin(2.0 * PI * i / periods[p]));
+        wavelet_decimate(tone, LONG_LENGTH, &config, tone_decimated);
+        double energy = 0.0;
+        for (int i = 0; i < (LONG_LENGTH >> LEVELS); i++) energy += (double)tone_decimated[i] * tone_decimated[i];
+        rms[p] = sqrt(energy / (LONG_LENGTH >> LEVELS));
+    }
+    double passband_rms = 1000.0 * 2.0 * sqrt(2.0) / sqrt(2.0);
+    ASSERT(rms[0] < 0.02 * passband_rms && fabs(rms[1] - passband_rms) < 0.01 * passband_rms,
+           "Decimation rejects content above the new Nyquist rate");
+
+    memcpy(zeroed, pyramid, sizeof(pyramid));
+    memset(zeroed + (LONG_LENGTH >> LEVELS), 0, sizeof(zeroed) - sizeof(decimated));
+    wavelet_reconstruct_blocked(zeroed, LONG_LENGTH, &config, reference);
+    ASSERT(wavelet_upsample(decimated, LONG_LENGTH, &config, upsampled) == LEVELS &&
+           memcmp(reference, upsampled, sizeof(upsampled)) == 0,
+           "Upsampling equals reconstruction with zero details");
+}
+
+void test_mra_components() {
+    printf("\n--- Running test_mra_components ---\n");
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.wavelet = WAVELET_DB4;
+    config.decomposition_levels = 4;
+
+    int16_t signal[TEST_SIGNAL_LENGTH];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        signal[i] = (int16_t)(original_signal[i] * 20 + ((i * 37) % 23) * 40 - 440);
+    }
+
+    static int16_t components[(MAX_DECOMPOSITION_LEVELS + 1) * TEST_SIGNAL_LENGTH];
+    int levels = wavelet_mra(signal, TEST_SIGNAL_LENGTH, &config, components);
+    ASSERT(levels == 4, "MRA reports the effective number of levels");
+
+    int exact = 1;
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        int32_t sum = 0;
+        for (int c = 0; c <= levels; c++) sum += components[c * TEST_SIGNAL_LENGTH + i];
+        exact &= sum == signal[i];
+    }
+    ASSERT(exact, "MRA components sum back to the signal exactly");
+
+    // Each component matches reconstructing its band with all others zeroed.
+    int16_t pyramid[TEST_SIGNAL_LENGTH], single[TEST_SIGNAL_LENGTH], band_only[TEST_SIGNAL_LENGTH];
+    wavelet_decompose(signal, TEST_SIGNAL_LENGTH, &config, pyramid);
+    int max_error = 0;
+    for (int c = 0; c <= levels; c++) {
+        uint8_t band = (c == levels) ? 0 : (uint8_t)(c + 1);
+        uint16_t offset = wavelet_band_offset(TEST_SIGNAL_LENGTH, (uint8_t)levels, band);
+        uint16_t band_len = wavelet_band_length(TEST_SIGNAL_LENGTH, (uint8_t)levels, band);
+        memset(single, 0, sizeof(single));
+        memcpy(single + offset, pyramid + offset, band_len * sizeof(int16_t));
+        wavelet_reconstruct(single, TEST_SIGNAL_LENGTH, &config, band_only);
+        for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+            int error = abs(band_only[i] - components[c * TEST_SIGNAL_LENGTH + i]);
+            if (error > max_error) max_error = error;
+        }
+    }
+    ASSERT(max_error <= 2 * levels, "MRA components match single-band reconstructions");
+}
+
+typedef struct {
+    int delivered;
+    int in_order;
+    int next_sequence[32];
+    int16_t* first_frame[32];
+    int failed;
+} aggregator_log_t;
+
+static void record_delivery(void* user, uint32_t stream_id, int16_t* frame, int status) {
+    aggregator_log_t* log = (aggregator_log_t*)user;
+    if (status != 0) log->failed++;
+    int sequence = (int)(frame - log->first_frame[stream_id]) / TEST_SIGNAL_LENGTH;
+    log->in_order &= sequence == log->next_sequence[stream_id];
+    log->next_sequence[stream_id]++;
+    log->delivered++;
+}
+
+void test_stream_aggregator() {
+    printf("\n--- Running test_stream_aggregator ---\n");
+    enum { STREAMS = 32, FRAMES_PER_STREAM = 3 };
+    static int16_t frames[STREAMS][FRAMES_PER_STREAM][TEST_SIGNAL_LENGTH];
+    static int16_t expected[STREAMS][FRAMES_PER_STREAM][TEST_SIGNAL_LENGTH];
+    for (int s = 0; s < STREAMS; s++) {
+        for (int f = 0; f < FRAMES_PER_STREAM; f++) {
+            for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+                frames[s][f][i] = (int16_t)(original_signal[(i + 7 * s) % TEST_SIGNAL_LENGTH] * (s + 1) / 4 +
+                                            ((i * (s + 3) + f * 11) % 17) * 5);
+            }
+        }
+    }
+    memcpy(expected, frames, sizeof(frames));
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.wavelet = WAVELET_SYMLET_4;
+    config.threshold_type = THRESHOLD_SOFT;
+    config.threshold_value = 20;
+    config.band_mode[0] = WAVELET_BAND_SCALE;
+    config.band_gain[0] = 12000;
+    for (int s = 0; s < STREAMS; s++) {
+        for (int f = 0; f < FRAMES_PER_STREAM; f++) wavelet_filter(expected[s][f], TEST_SIGNAL_LENGTH, &config);
+    }
+
+    // The batch filter on its own, with a partial final group.
+    static int16_t batch_frames[11][TEST_SIGNAL_LENGTH];
+    int16_t* batch[11];
+    for (int f = 0; f < 11; f++) {
+        memcpy(batch_frames[f], frames[f][0], sizeof(batch_frames[f]));
+        batch[f] = batch_frames[f];
+    }
+    int batch_ok = wavelet_filter_batch(batch, 11, TEST_SIGNAL_LENGTH, &config) == 0;
+    for (int f = 0; f < 11; f++) batch_ok &= memcmp(batch_frames[f], expected[f][0], sizeof(batch_frames[f])) == 0;
+    ASSERT(batch_ok, "Lane-parallel batch matches per-frame filtering");
+
+    // Streams become ready at unrelated times; the clock advances 10 us per step.
+    aggregator_log_t log;
+    memset(&log, 0, sizeof(log));
+    log.in_order = 1;
+    for (int s = 0; s < STREAMS; s++) log.first_frame[s] = frames[s][0];
+
+    wavelet_aggregator_t aggregator;
+    ASSERT(wavelet_aggregator_init(&aggregator, &config, TEST_SIGNAL_LENGTH, 250, record_delivery, &log) == 0,
+           "Aggregator initializes");
+    uint64_t now = 0;
+    int submitted = 0;
+    int max_wait_ok = 1;
+    for (int f = 0; f < FRAMES_PER_STREAM; f++) {
+        for (int s = 0; s < STREAMS; s++) {
+            if ((s * 7 + f) % 5 == 0) now += 400; // Occasional quiet periods
+            now += 10;
+            max_wait_ok &= wavelet_aggregator_poll(&aggregator, now) >= 0;
+            max_wait_ok &= wavelet_aggregator_deadline(&aggregator, now) <= 250 ||
+                           wavelet_aggregator_deadline(&aggregator, now) == UINT64_MAX;
+            wavelet_aggregator_submit(&aggregator, (uint32_t)s, frames[s][f], now);
+            submitted++;
+        }
+    }
+    ASSERT(aggregator.pending < WAVELET_BATCH_LANES, "Full batches run as soon as every lane is taken");
+    uint64_t wait = wavelet_aggregator_deadline(&aggregator, now);
+    ASSERT(aggregator.pending == 0 || (wavelet_aggregator_poll(&aggregator, now + wait - 1) == 0 &&
+                                       wavelet_aggregator_poll(&aggregator, now + wait) > 0),
+           "Partial batches run exactly when the maximum delay expires");
+    wavelet_aggregator_flush(&aggregator);
+
+    ASSERT(log.delivered == submitted && log.in_order, "Every frame is delivered once, in order per stream");
+    ASSERT(aggregator.batches < (uint64_t)submitted && aggregator.frames_filtered == (uint64_t)submitted,
+           "Frames from different streams share batches");
+    ASSERT(memcmp(frames, expected, sizeof(frames)) == 0 && max_wait_ok, "Aggregated frames match per-frame filtering");
+
+    // A batch that cannot be filtered still empties the queue: its frames
+    // come back unfiltered and the next batch starts from lane 0.
+    memset(&log, 0, sizeof(log));
+    log.in_order = 1;
+    for (int s = 0; s < STREAMS; s++) log.first_frame[s] = frames[s][0];
+    memcpy(frames, expected, sizeof(frames));
+    aggregator.config.decomposition_levels = 0;
+    int failures = 0;
+    for (int s = 0; s < WAVELET_BATCH_LANES; s++) {
+        failures += wavelet_aggregator_submit(&aggregator, (uint32_t)s, frames[s][0], now) < 0;
+    }
+    int failed_ok = failures == 1 && aggregator.pending == 0 && log.failed == WAVELET_BATCH_LANES &&
+                    aggregator.frames_failed == WAVELET_BATCH_LANES &&
+                    memcmp(frames, expected, sizeof(frames)) == 0;
+    aggregator.config = config;
+    failed_ok &= wavelet_aggregator_submit(&aggregator, 0, frames[0][1], now) == 0 && aggregator.pending == 1 &&
+                 aggregator.frames[0] == frames[0][1] && wavelet_aggregator_flush(&aggregator) == 1 &&
+                 log.delivered == WAVELET_BATCH_LANES + 1 && log.failed == WAVELET_BATCH_LANES;
+    ASSERT(failed_ok, "A failed batch is handed back unfiltered and clears the queue");
+}
+
+enum { RING_STRESS_SAMPLES = 1 << 21 };
+
+static void* ring_stress_producer(void* arg) {
+    wavelet_ring_t* ring = (wavelet_ring_t*)arg;
+    int16_t chunk[300];
+    uint32_t sent = 0;
+    uint32_t seed = 12345;
+    while (sent < RING_STRESS_SAMPLES) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t count = 1 + (seed >> 16) % 300;
+        if (count > RING_STRESS_SAMPLES - sent) count = RING_STRESS_SAMPLES - sent;
+        for (uint32_t i = 0; i < count; i++) chunk[i] = (int16_t)(sent + i);
+        uint32_t done = 0;
+        while (done < count) done += wavelet_ring_push(ring, chunk + done, count - done);
+        sent += count;
+    }
+    wavelet_ring_publish(ring);
+    return NULL;
+}
+
+void test_spsc_ring() {
+    printf("\n--- Running test_spsc_ring ---\n");
+    static int16_t storage[1024];
+    wavelet_ring_t ring;
+    ASSERT(wavelet_ring_init(&ring, storage, 1000, 64) == -1, "Ring rejects capacities that are not powers of two");
+    ASSERT(wavelet_ring_init(&ring, storage, 1024, 64) == 0, "Ring initializes");
+
+    // Stress: odd-sized pushes and pops across a small ring, checked in order.
+    pthread_t producer;
+    int started = pthread_create(&producer, NULL, ring_stress_producer, &ring) == 0;
+    uint32_t received = 0;
+    int in_order = 1;
+    int16_t chunk[257];
+    uint32_t seed = 777;
+    while (started && received < RING_STRESS_SAMPLES) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t got = wavelet_ring_pop(&ring, chunk, 1 + (seed >> 16) % 257);
+        for (uint32_t i = 0; i < got; i++) in_order &= chunk[i] == (int16_t)(received + i);
+        received += got;
+    }
+    if (started) pthread_join(producer, NULL);
+    ASSERT(started && received == RING_STRESS_SAMPLES && in_order, "Ring delivers every sample once and in order under load");
+    ASSERT(wavelet_ring_available(&ring) == 0, "Ring is empty after the stress run");
+
+    // Unpublished samples stay invisible until the batch fills or is published.
+    wavelet_ring_init(&ring, storage, 1024, 64);
+    wavelet_ring_push(&ring, original_signal, 10);
+    int hidden = wavelet_ring_available(&ring) == 0;
+    wavelet_ring_publish(&ring);
+    ASSERT(hidden && wavelet_ring_available(&ring) == 10, "Ring publishes indices in batches");
+    static int16_t filler[2000];
+    ASSERT(wavelet_ring_push(&ring, filler, 2000) == 1014, "Ring push never blocks when full");
+
+    // The streaming filter consumes frame-sized chunks from the ring.
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.threshold_type = THRESHOLD_SOFT;
+    config.threshold_value = 10;
+    wavelet_stream_t direct, ringed;
+    wavelet_stream_init(&direct, &config, 64);
+    wavelet_stream_init(&ringed, &config, 64);
+    wavelet_ring_init(&ring, storage, 1024, 32);
+    wavelet_ring_push(&ring, original_signal, 150);
+    wavelet_ring_publish(&ring);
+    int16_t expected[64], frame[64];
+    int frames = 0, match = 1;
+    while (wavelet_stream_consume(&ringed, &ring, frame) == 1) {
+        memcpy(expected, original_signal + 64 * frames, sizeof(expected));
+        wavelet_stream_process(&direct, expected);
+        match &= memcmp(expected, frame, sizeof(frame)) == 0;
+        frames++;
+    }
+    ASSERT(frames == 2 && match && wavelet_ring_available(&ring) == 22,
+           "Stream consumes whole frames from the ring and leaves the remainder");
+}
+
+typedef struct {
+    const int16_t* data;
+    uint32_t length;
+    uint32_t position;
+    uint32_t max_read;    // Forces short reads
+    int16_t* out;
+    uint32_t written;
+    uint32_t fail_after;  // Write error once this many samples are written
+} pipeline_io_t;
+
+static int32_t pipeline_test_read(void* io, int16_t* samples, uint32_t max_count) {
+    pipeline_io_t* state = (pipeline_io_t*)io;
+    uint32_t count = state->length - state->position;
+    if (count > max_count) count = max_count;
+    if (count > state->max_read) count = state->max_read;
+    memcpy(samples, state->data + state->position, count * sizeof(int16_t));
+    state->position += count;
+    return (int32_t)count;
+}
+
+static int pipeline_test_write(void* io, const int16_t* samples, uint32_t count) {
+    pipeline_io_t* state = (pipeline_io_t*)io;
+    if (state->written + count > state->fail_after) return -1;
+    memcpy(state->out + state->written, samples, count * sizeof(int16_t));
+    state->written += count;
+    return 0;
+}
+
+void test_filter_pipeline() {
+    printf("\n--- Running test_filter_pipeline ---\n");
+    enum { PIPELINE_LENGTH = 50000, BLOCK = 256 };
+    static int16_t input[PIPELINE_LENGTH], output[PIPELINE_LENGTH], expected[PIPELINE_LENGTH];
+    for (int i = 0; i < PIPELINE_LENGTH; i++) {
+        input[i] = (int16_t)(1500.0 * sin(2.0 * PI * i / 333.0) + ((i * 7919) % 401) - 200);
+    }
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.threshold_type = THRESHOLD_SOFT;
+    config.threshold_value = 60;
+
+    // Reference: a single long-filter pass over the whole input.
+    wavelet_long_config_t long_config = { WAVELET_EXTEND_SYMMETRIC, 1, 0 };
+    wavelet_filter_long(input, PIPELINE_LENGTH, &config, &long_config, expected);
+
+    pipeline_io_t io = { input, PIPELINE_LENGTH, 0, 100, output, 0, UINT32_MAX };
+    wavelet_pipeline_config_t pipeline;
+    memset(&pipeline, 0, sizeof(pipeline));
+    pipeline.block_length = BLOCK;
+    pipeline.num_workers = 3;
+    pipeline.num_buffers = 5;
+    pipeline.extension = WAVELET_EXTEND_SYMMETRIC;
+    pipeline.read = pipeline_test_read;
+    pipeline.write = pipeline_test_write;
+    pipeline.read_io = &io;
+    pipeline.write_io = &io;
+    ASSERT(wavelet_pipeline_run(&config, &pipeline) == 0 && io.written == PIPELINE_LENGTH,
+           "Pipeline filters the whole input");
+    ASSERT(memcmp(output, expected, sizeof(output)) == 0, "Pipeline output is in order and matches one long-filter pass without seams");
+
+    pipeline_io_t failing = { input, PIPELINE_LENGTH, 0, PIPELINE_LENGTH, output, 0, 10 * BLOCK };
+    pipeline.read_io = &failing;
+    pipeline.write_io = &failing;
+    ASSERT(wavelet_pipeline_run(&config, &pipeline) == -1 && failing.written == 10 * BLOCK,
+           "Pipeline stops and reports write errors");
+}
+
+#ifdef WAVELET_WITH_SERVICE
+typedef struct {
+    wavelet_client_t* client;
+    int seed;
+    int ok;
+} service_job_t;
+
+static void* service_test_client(void* arg) {
+    service_job_t* job = (service_job_t*)arg;
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.threshold_type = THRESHOLD_SOFT;
+    job->ok = 1;
+    for (int r = 0; r < 300; r++) {
+        int16_t remote[TEST_SIGNAL_LENGTH], local[TEST_SIGNAL_LENGTH];
+        uint16_t length = (uint16_t)(64 + (r * 37 + job->seed) % (TEST_SIGNAL_LENGTH - 63));
+        for (int i = 0; i < length; i++) remote[i] = (int16_t)(((i + r) * (job->seed + 13)) % 911 - 455);
+        memcpy(local, remote, sizeof(remote));
+        config.wavelet = (r % 2) ? WAVELET_DB6 : WAVELET_SYMLET_5;
+        config.threshold_value = (int16_t)(20 + r % 50);
+        wavelet_filter(local, length, &config);
+        job->ok &= wavelet_client_filter(job->client, remote, length, &config) == 0;
+        job->ok &= memcmp(remote, local, length * sizeof(int16_t)) == 0;
+    }
+    return NULL;
+}
+
+void test_filter_service() {
+    printf("\n--- Running test_filter_service ---\n");
+    const char* path = "/tmp/wavelet_filter_test.sock";
+    wavelet_service_t* service = wavelet_service_start(path, 2);
+    ASSERT(service != NULL, "Service starts");
+    if (!service) return;
+
+    wavelet_client_t* client = wavelet_client_connect(path);
+    wavelet_client_t* second = wavelet_client_connect(path);
+    ASSERT(client != NULL && second != NULL, "Clients connect and map the request region");
+    if (!client || !second) {
+        wavelet_client_disconnect(client);
+        wavelet_client_disconnect(second);
+        wavelet_service_stop(service);
+        return;
+    }
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    config.threshold_type = THRESHOLD_SPIKE;
+    config.threshold_value = 100;
+    int16_t remote[TEST_SIGNAL_LENGTH], local[TEST_SIGNAL_LENGTH];
+    generate_test_signal();
+    memcpy(remote, test_signal, sizeof(remote));
+    memcpy(local, test_signal, sizeof(local));
+    wavelet_filter(local, TEST_SIGNAL_LENGTH, &config);
+    ASSERT(wavelet_client_filter(client, remote, TEST_SIGNAL_LENGTH, &config) == 0 &&
+           memcmp(remote, local, sizeof(local)) == 0, "Service result equals wavelet_filter()");
+    ASSERT(wavelet_client_filter(client, remote, 0, &config) == -1, "Client rejects invalid lengths");
+
+    // Several threads over two clients keep many slots in flight at once.
+    service_job_t jobs[4] = { { client, 1, 0 }, { client, 2, 0 }, { second, 3, 0 }, { second, 4, 0 } };
+    pthread_t threads[4];
+    int all_ok = 1;
+    for (int t = 0; t < 4; t++) all_ok &= pthread_create(&threads[t], NULL, service_test_client, &jobs[t]) == 0;
+    for (int t = 0; t < 4 && all_ok; t++) pthread_join(threads[t], NULL);
+    for (int t = 0; t < 4; t++) all_ok &= jobs[t].ok;
+    ASSERT(all_ok, "Concurrent requests from several clients all match wavelet_filter()");
+
+    wavelet_service_stop(service);
+    memcpy(remote, local, sizeof(local));
+    ASSERT(wavelet_client_filter(client, remote, TEST_SIGNAL_LENGTH, &config) == -1,
+           "Clients fail cleanly once the service has stopped");
+    ASSERT(wavelet_client_connect(path) == NULL, "Service removes its socket on stop");
+    wavelet_client_disconnect(client);
+    wavelet_client_disconnect(second);
+}
+
+static void* service_hammer(void* arg) {
+    wavelet_client_t* client = (wavelet_client_t*)arg;
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    int16_t frame[TEST_SIGNAL_LENGTH];
+    for (;;) {
+        for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) frame[i] = (int16_t)((i * 37) % 401 - 200);
+        wavelet_client_filter(client, frame, TEST_SIGNAL_LENGTH, &config);
+    }
+    return NULL;
+}
+
+static void sleep_ms(long ms) {
+    struct timespec pause = { ms / 1000, (ms % 1000) * 1000000 };
+    nanosleep(&pause, NULL);
+}
+
+void test_service_failures() {
+    printf("\n--- Running test_service_failures ---\n");
+    const char* path = "/tmp/wavelet_filter_failures.sock";
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    int16_t frame[TEST_SIGNAL_LENGTH];
+    generate_test_signal();
+    memcpy(frame, test_signal, sizeof(frame));
+
+    // A client process killed with requests in flight leaves slots behind.
+    wavelet_service_t* service = wavelet_service_start(path, 2);
+    ASSERT(service != NULL, "Service starts");
+    if (!service) return;
+    int ready[2];
+    pid_t child = (pipe(ready) == 0) ? fork() : -1;
+    if (child == 0) {
+        wavelet_client_t* client = wavelet_client_connect(path);
+        pthread_t threads[8];
+        for (int t = 0; client && t < 8; t++) pthread_create(&threads[t], NULL, service_hammer, client);
+        char byte = client ? 1 : 0;
+        if (write(ready[1], &byte, 1) != 1) _exit(1);
+        for (;;) pause();
+    }
+    char byte = 0;
+    int reclaimed = child > 0 && read(ready[0], &byte, 1) == 1 && byte == 1;
+    sleep_ms(20);
+    if (child > 0) {
+        kill(child, SIGKILL);
+        waitpid(child, NULL, 0);
+    }
+    for (int wait = 0; reclaimed && wait < 200 && wavelet_service_slots_in_use(service) != 0; wait++) sleep_ms(10);
+    reclaimed &= wavelet_service_slots_in_use(service) == 0;
+    wavelet_client_t* client = wavelet_client_connect(path);
+    reclaimed &= client && wavelet_client_filter(client, frame, TEST_SIGNAL_LENGTH, &config) == 0;
+    ASSERT(reclaimed, "Slots of a killed client are reclaimed");
+    wavelet_client_disconnect(client);
+    wavelet_service_stop(service);
+    close(ready[0]);
+    close(ready[1]);
+
+    // A service process killed under a connected client.
+    child = (pipe(ready) == 0) ? fork() : -1;
+    if (child == 0) {
+        byte = wavelet_service_start(path, 1) != NULL;
+        if (write(ready[1], &byte, 1) != 1) _exit(1);
+        for (;;) pause();
+    }
+    byte = 0;
+    client = (child > 0 && read(ready[0], &byte, 1) == 1 && byte == 1) ? wavelet_client_connect(path) : NULL;
+    int noticed = client && wavelet_client_filter(client, frame, TEST_SIGNAL_LENGTH, &config) == 0;
+    if (child > 0) {
+        kill(child, SIGKILL);
+        waitpid(child, NULL, 0);
+    }
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    noticed &= client && wavelet_client_filter(client, frame, TEST_SIGNAL_LENGTH, &config) == -1;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double waited_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+    ASSERT(noticed && waited_ms < WAVELET_SERVICE_TIMEOUT_MS, "Clients notice a killed service instead of hanging");
+    wavelet_client_disconnect(client);
+    unlink(path);
+    close(ready[0]);
+    close(ready[1]);
+}
+#endif // WAVELET_WITH_SERVICE
+
 void test_edge_cases() {
     printf("\n--- Running test_edge_cases ---\n");
     int16_t empty_signal[] = {};
@@ -202,6 +1508,33 @@ int main() {
     test_reconstruction_energy();
     test_spike_removal_db4();
     test_spike_removal_haar();
+    test_decompose_reconstruct();
+    test_feature_extraction();
+    test_threshold_sweep();
+    test_incremental_update();
+    test_spike_detection();
+    test_spike_patching();
+    test_band_modes();
+    test_per_level_thresholds();
+    test_block_thresholding();
+    test_adaptive_threshold();
+    test_wavelet_families();
+    test_custom_wavelet();
+    test_cwt_scalogram();
+    test_dual_tree();
+    test_haar_engine();
+    test_inplace_transform();
+    test_blocked_cascade();
+    test_long_filter();
+    test_decimator();
+    test_mra_components();
+    test_stream_aggregator();
+    test_spsc_ring();
+    test_filter_pipeline();
+#ifdef WAVELET_WITH_SERVICE
+    test_filter_service();
+    test_service_failures();
+#endif
     test_edge_cases();
 
     printf("\n----------------------------------------\n");
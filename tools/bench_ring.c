@@ -0,0 +1,123 @@
+/**
+ * @file bench_ring.c
+ * @brief Throughput and latency of ring-fed streaming filtering.
+ *
+ * An acquisition thread pushes samples in small bursts while the main
+ * thread filters frames with wavelet_stream_consume(). Throughput is
+ * measured over the whole run. Latency is the time from handing a frame's
+ * last sample to the ring to the end of its filtering, so it includes the batched
+ * index publication.
+ *
+ * Usage: bench_ring [frames] [frame_length] [publish_batch]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "wavelet_filter.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_RING_CAPACITY 16384
+#define BENCH_BURST 32
+
+typedef struct {
+    wavelet_ring_t* ring;
+    uint32_t total;
+    uint16_t frame_length;
+    uint64_t* frame_push_ns; // Push time of each frame's last sample
+} producer_args_t;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void* producer(void* arg) {
+    producer_args_t* args = (producer_args_t*)arg;
+    int16_t burst[BENCH_BURST];
+    uint32_t sent = 0;
+    while (sent < args->total) {
+        uint32_t count = args->total - sent;
+        if (count > BENCH_BURST) count = BENCH_BURST;
+        for (uint32_t i = 0; i < count; i++) burst[i] = (int16_t)(((sent + i) * 7919u) % 2001u) - 1000;
+
+        // Stamp the frames this burst completes before pushing it; the ring's
+        // release store makes the stamps visible along with the samples.
+        uint64_t stamp = now_ns();
+        for (uint32_t s = sent; s < sent + count; s++) {
+            if ((s + 1) % args->frame_length == 0) args->frame_push_ns[s / args->frame_length] = stamp;
+        }
+
+        uint32_t done = 0;
+        while (done < count) {
+            uint32_t pushed = wavelet_ring_push(args->ring, burst + done, count - done);
+            if (pushed == 0) sched_yield(); // Full: let the consumer run on small machines
+            done += pushed;
+        }
+        sent += count;
+    }
+    wavelet_ring_publish(args->ring);
+    return NULL;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char** argv) {
+    uint32_t frames = (argc > 1) ? (uint32_t)atol(argv[1]) : 200000;
+    uint16_t frame_length = (argc > 2) ? (uint16_t)atoi(argv[2]) : 128;
+    uint32_t publish_batch = (argc > 3) ? (uint32_t)atol(argv[3]) : 64;
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    wavelet_stream_t stream;
+    if (wavelet_stream_init(&stream, &config, frame_length) != 0) {
+        fprintf(stderr, "invalid frame length\n");
+        return 1;
+    }
+
+    static int16_t storage[BENCH_RING_CAPACITY];
+    wavelet_ring_t ring;
+    wavelet_ring_init(&ring, storage, BENCH_RING_CAPACITY, publish_batch);
+
+    uint64_t* pushed = (uint64_t*)calloc(frames, sizeof(uint64_t));
+    uint64_t* latency = (uint64_t*)calloc(frames, sizeof(uint64_t));
+    int16_t* frame = (int16_t*)malloc(frame_length * sizeof(int16_t));
+    if (!pushed || !latency || !frame) return 1;
+
+    producer_args_t args = { &ring, frames * frame_length, frame_length, pushed };
+    pthread_t thread;
+    uint64_t start = now_ns();
+    if (pthread_create(&thread, NULL, producer, &args) != 0) return 1;
+
+    uint32_t done = 0;
+    while (done < frames) {
+        int status = wavelet_stream_consume(&stream, &ring, frame);
+        if (status < 0) return 1;
+        if (status == 0) {
+            sched_yield();
+            continue;
+        }
+        latency[done] = now_ns() - pushed[done];
+        done++;
+    }
+    uint64_t elapsed = now_ns() - start;
+    pthread_join(thread, NULL);
+
+    qsort(latency, frames, sizeof(uint64_t), compare_u64);
+    printf("frames %u x %u samples, publish batch %u\n", frames, frame_length, publish_batch);
+    printf("throughput: %.1f Msamples/s\n", (double)frames * frame_length * 1e3 / (double)elapsed);
+    printf("latency: p50 %.1f us, p99 %.1f us, max %.1f us\n",
+           latency[frames / 2] / 1e3, latency[(uint64_t)frames * 99 / 100] / 1e3, latency[frames - 1] / 1e3);
+
+    free(pushed);
+    free(latency);
+    free(frame);
+    return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file bench_service.c
+ * @brief Round-trip latency of the local filtering service.
+ *
+ * The process forks before starting the service: the parent runs it and
+ * the child connects as an ordinary client, so requests really cross a
+ * process boundary. Latency is measured around each wavelet_client_filter()
+ * call, i.e. copy in, queueing, filtering, wake-up and copy out.
+ *
+ * Usage: bench_service [requests] [frame_length] [service_threads]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "wavelet_filter.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_SOCKET "/tmp/wavelet_bench_service.sock"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int run_client(uint32_t requests, uint16_t frame_length) {
+    wavelet_client_t* client = NULL;
+    for (int attempt = 0; attempt < 500 && !client; attempt++) {
+        client = wavelet_client_connect(BENCH_SOCKET);
+        if (!client) {
+            struct timespec pause = { 0, 10000000 };
+            nanosleep(&pause, NULL);
+        }
+    }
+    if (!client) {
+        fprintf(stderr, "cannot connect to %s\n", BENCH_SOCKET);
+        return 1;
+    }
+
+    wavelet_config_t config;
+    wavelet_get_default_config(&config);
+    uint64_t* latency = (uint64_t*)calloc(requests, sizeof(uint64_t));
+    int16_t* frame = (int16_t*)malloc(frame_length * sizeof(int16_t));
+    if (!latency || !frame) return 1;
+
+    uint64_t start = now_ns();
+    for (uint32_t r = 0; r < requests; r++) {
+        for (uint16_t i = 0; i < frame_length; i++) frame[i] = (int16_t)(((r + i) * 7919u) % 2001u) - 1000;
+        uint64_t t0 = now_ns();
+        if (wavelet_client_filter(client, frame, frame_length, &config) != 0) return 1;
+        latency[r] = now_ns() - t0;
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    qsort(latency, requests, sizeof(uint64_t), compare_u64);
+    printf("requests %u x %u samples\n", requests, frame_length);
+    printf("throughput: %.0f requests/s\n", (double)requests * 1e9 / (double)elapsed);
+    printf("round trip: p50 %.1f us, p99 %.1f us, max %.1f us\n",
+           latency[requests / 2] / 1e3, latency[(uint64_t)requests * 99 / 100] / 1e3, latency[requests - 1] / 1e3);
+
+    wavelet_client_disconnect(client);
+    free(latency);
+    free(frame);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    uint32_t requests = (argc > 1) ? (uint32_t)atol(argv[1]) : 100000;
+    uint16_t frame_length = (argc > 2) ? (uint16_t)atoi(argv[2]) : 128;
+    uint32_t threads = (argc > 3) ? (uint32_t)atol(argv[3]) : 1;
+    if (requests == 0 || frame_length == 0 || frame_length > MAX_SIGNAL_LENGTH) {
+        fprintf(stderr, "frame_length must be 1..%d\n", MAX_SIGNAL_LENGTH);
+        return 1;
+    }
+
+    pid_t child = fork();
+    if (child < 0) return 1;
+    if (child == 0) return run_client(requests, frame_length);
+
+    wavelet_service_t* service = wavelet_service_start(BENCH_SOCKET, threads);
+    if (!service) {
+        fprintf(stderr, "cannot start service on %s\n", BENCH_SOCKET);
+        kill(child, SIGTERM);
+        return 1;
+    }
+    int status = 1;
+    waitpid(child, &status, 0);
+    wavelet_service_stop(service);
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : 1;
+}
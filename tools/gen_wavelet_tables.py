@@ -0,0 +1,330 @@
+#!/usr/bin/env python3
+"""
+Generates wavelet_tables.c: Q14 filter banks for the Daubechies (db2-db20),
+Symlet (sym2-sym20) and Coiflet (coif1-coif5) families.
+
+Daubechies and Symlet low-pass filters come from the spectral factorization
+of the Daubechies polynomial: db keeps the minimum-phase roots, sym picks the
+root of each reciprocal pair that makes the phase closest to linear.
+Coiflets are solved from their moment and orthogonality conditions with
+Levenberg-Marquardt, each order started from the previous one.
+
+Only the Python standard library is used. Usage:
+    python3 tools/gen_wavelet_tables.py > wavelet_tables.c
+"""
+
+import cmath
+import itertools
+import math
+import sys
+
+Q = 14
+
+
+# --- Daubechies polynomial factorization ------------------------------------
+
+def poly_roots(coeffs):
+    """Roots of sum(coeffs[k] * x^k) (Durand-Kerner, then Newton polish)."""
+    n = len(coeffs) - 1
+    a = [c / coeffs[-1] for c in coeffs]
+
+    def p(x):
+        v = 0j
+        for c in reversed(a):
+            v = v * x + c
+        return v
+
+    def dp(x):
+        v = 0j
+        for k in range(n, 0, -1):
+            v = v * x + k * a[k]
+        return v
+
+    radius = 1 + max(abs(c) for c in a[:-1])
+    roots = [radius * cmath.exp(2j * math.pi * (k + 0.25) / n) for k in range(n)]
+    for _ in range(5000):
+        delta = 0.0
+        updated = []
+        for i, r in enumerate(roots):
+            den = 1
+            for j, s in enumerate(roots):
+                if i != j:
+                    den *= r - s
+            step = p(r) / den
+            updated.append(r - step)
+            delta = max(delta, abs(step))
+        roots = updated
+        if delta < 1e-15 * radius:
+            break
+
+    polished = []
+    for r in roots:
+        for _ in range(50):
+            step = p(r) / dp(r)
+            r -= step
+            if abs(step) < 1e-17:
+                break
+        polished.append(r)
+    return polished
+
+
+def polymul(a, b):
+    out = [0j] * (len(a) + len(b) - 1)
+    for i, x in enumerate(a):
+        for j, y in enumerate(b):
+            out[i + j] += x * y
+    return out
+
+
+def inner_zeros(N):
+    """Zeros inside the unit circle of the order-N Daubechies factorization."""
+    if N == 1:
+        return []
+    # P(y) = sum_{k<N} C(N-1+k, k) y^k with y = (1 - (z + 1/z) / 2) / 2.
+    zeros = []
+    for y in poly_roots([math.comb(N - 1 + k, k) for k in range(N)]):
+        b = 2 - 4 * y
+        disc = cmath.sqrt(b * b - 4)
+        r1, r2 = (b + disc) / 2, (b - disc) / 2
+        zeros.append(r1 if abs(r1) < 1 else r2)
+    return zeros
+
+
+def low_pass(N, zeros):
+    h = [1 + 0j]
+    for _ in range(N):
+        h = polymul(h, [1, 1])
+    for r in zeros:
+        h = polymul(h, [1, -r])
+    h = [x.real for x in h]
+    scale = math.sqrt(2) / sum(h)
+    return [x * scale for x in h]
+
+
+def daubechies(N):
+    return low_pass(N, inner_zeros(N))
+
+
+def phase_nonlinearity(h):
+    """Largest deviation of the unwrapped phase from its best linear fit."""
+    points = 200
+    ws = [0.9 * math.pi * (k + 0.5) / points for k in range(points)]
+    phases = []
+    prev = None
+    offset = 0.0
+    for w in ws:
+        ph = cmath.phase(sum(c * cmath.exp(-1j * w * n) for n, c in enumerate(h)))
+        if prev is not None:
+            while ph + offset - prev > math.pi:
+                offset -= 2 * math.pi
+            while ph + offset - prev < -math.pi:
+                offset += 2 * math.pi
+        prev = ph + offset
+        phases.append(prev)
+    mw = sum(ws) / points
+    mp = sum(phases) / points
+    slope = sum((w - mw) * (p - mp) for w, p in zip(ws, phases)) / sum((w - mw) ** 2 for w in ws)
+    return max(abs(p - (mp + slope * (w - mw))) for w, p in zip(ws, phases))
+
+
+def symlet(N):
+    # Conjugate zeros must be flipped together to keep the filter real.
+    zeros = inner_zeros(N)
+    groups = []
+    used = [False] * len(zeros)
+    for i, z in enumerate(zeros):
+        if used[i]:
+            continue
+        used[i] = True
+        if abs(z.imag) < 1e-9:
+            groups.append([complex(z.real, 0)])
+            continue
+        j = min((k for k in range(len(zeros)) if not used[k]), key=lambda k: abs(zeros[k] - z.conjugate()))
+        used[j] = True
+        groups.append([z, z.conjugate()])
+
+    best = None
+    for choice in itertools.product([0, 1], repeat=len(groups)):
+        chosen = []
+        for flip, group in zip(choice, groups):
+            chosen += [z if flip == 0 else 1 / z.conjugate() for z in group]
+        h = low_pass(N, chosen)
+        score = phase_nonlinearity(h)
+        if best is None or score < best[0] - 1e-12:
+            best = (score, h)
+    h = best[1]
+
+    # Both time directions are equally asymmetric; use the front-loaded one,
+    # like the minimum-phase Daubechies filters.
+    centroid = sum(i * x * x for i, x in enumerate(h))
+    return h[::-1] if centroid > (len(h) - 1) / 2 else h
+
+
+# --- Coiflets ------------------------------------------------------------------
+
+def coiflet_system(h, K):
+    """Residuals and Jacobian of the order-K coiflet conditions.
+
+    Taps are indexed -2K .. 4K-1: the scaling function has vanishing moments
+    1 .. 2K-1 about index 0, the wavelet has vanishing moments 0 .. 2K-1, and
+    the filter is orthonormal with DC gain sqrt(2). Moments use n / 3K so the
+    rows stay well scaled.
+    """
+    L = 6 * K
+    t = [(n - 2 * K) / (3.0 * K) for n in range(L)]
+    sign = [(-1) ** ((n - 2 * K) % 2) for n in range(L)]
+    rows = [[1.0] * L]
+    for p in range(1, 2 * K):
+        rows.append([x ** p for x in t])
+    for p in range(0, 2 * K):
+        rows.append([s * x ** p for s, x in zip(sign, t)])
+    r = [sum(h) - math.sqrt(2)] + [sum(a * b for a, b in zip(row, h)) for row in rows[1:]]
+    J = rows[:]
+    for m in range(0, 3 * K):
+        r.append(sum(h[k] * h[k + 2 * m] for k in range(L - 2 * m)) - (1 if m == 0 else 0))
+        J.append([(h[j + 2 * m] if j + 2 * m < L else 0.0) + (h[j - 2 * m] if j - 2 * m >= 0 else 0.0)
+                  for j in range(L)])
+    return r, J
+
+
+def lstsq(J, r):
+    """Solves min ||J d + r|| with Householder QR."""
+    M, L = len(J), len(J[0])
+    A = [row[:] for row in J]
+    b = [-x for x in r]
+    for c in range(L):
+        norm = math.sqrt(sum(A[i][c] ** 2 for i in range(c, M)))
+        if norm == 0:
+            continue
+        alpha = -norm if A[c][c] > 0 else norm
+        v = [0.0] * M
+        v[c] = A[c][c] - alpha
+        for i in range(c + 1, M):
+            v[i] = A[i][c]
+        vn = sum(x * x for x in v[c:])
+        if vn == 0:
+            continue
+        for k in range(c, L):
+            s = 2 * sum(v[i] * A[i][k] for i in range(c, M)) / vn
+            for i in range(c, M):
+                A[i][k] -= s * v[i]
+        s = 2 * sum(v[i] * b[i] for i in range(c, M)) / vn
+        for i in range(c, M):
+            b[i] -= s * v[i]
+    d = [0.0] * L
+    for i in range(L - 1, -1, -1):
+        d[i] = (b[i] - sum(A[i][k] * d[k] for k in range(i + 1, L))) / A[i][i]
+    return d
+
+
+def solve_coiflet(K, start):
+    h = start[:]
+    L = len(h)
+    lam = 1e-2
+    r, J = coiflet_system(h, K)
+    cost = sum(x * x for x in r)
+    for _ in range(3000):
+        damped = J + [[math.sqrt(lam) if i == j else 0.0 for j in range(L)] for i in range(L)]
+        d = lstsq(damped, r + [0.0] * L)
+        candidate = [a + b for a, b in zip(h, d)]
+        rn, Jn = coiflet_system(candidate, K)
+        cn = sum(x * x for x in rn)
+        if cn < cost:
+            h, r, J, cost = candidate, rn, Jn, cn
+            lam = max(lam / 3, 1e-30)
+            if cost < 1e-31:
+                break
+        else:
+            lam *= 4
+            if lam > 1e12:
+                break
+    return h, cost
+
+
+def coiflets(max_order):
+    out = []
+    prev = None
+    for K in range(1, max_order + 1):
+        L = 6 * K
+        if prev is None:
+            # Windowed half-band sinc centred on index 0.
+            start = []
+            for n in range(L):
+                x = n - 2 * K
+                s = 1.0 if x == 0 else math.sin(math.pi * x / 2) / (math.pi * x / 2)
+                start.append(s * (0.5 + 0.5 * math.cos(math.pi * x / (3 * K))))
+            scale = math.sqrt(2) / sum(start)
+            start = [x * scale for x in start]
+        else:
+            start = [0.0] * L
+            for i, v in enumerate(prev):
+                start[i + 2] = v
+        h, cost = solve_coiflet(K, start)
+        if cost > 1e-15:
+            raise RuntimeError("coif%d did not converge (residual %g)" % (K, cost))
+        out.append(h)
+        prev = h
+    return out
+
+
+# --- Output -----------------------------------------------------------------------
+
+def quantize(h):
+    """Rounds to Q14 and nudges the largest tap so the DC gain stays sqrt(2)."""
+    taps = [int(round(x * (1 << Q))) for x in h]
+    target = int(round(math.sqrt(2) * (1 << Q)))
+    largest = max(range(len(taps)), key=lambda k: abs(taps[k]))
+    taps[largest] += target - sum(taps)
+    if sum(abs(x) for x in taps) * 32768 >= 2 ** 31:
+        raise RuntimeError("filter gain overflows the 32-bit accumulator")
+    return taps
+
+
+def emit(out, name, taps):
+    L = len(taps)
+    h1 = [taps[L - 1 - k] * (-1 if k & 1 else 1) for k in range(L)]
+    g0 = taps[::-1]
+    g1 = h1[::-1]
+    for suffix, values in (("h0", taps), ("h1", h1), ("g0", g0), ("g1", g1)):
+        out.write("static const int16_t %s_%s[] = {" % (name, suffix))
+        for i, v in enumerate(values):
+            if i % 10 == 0:
+                out.write("\n    ")
+            out.write("%d%s" % (v, "," if i + 1 < L else ""))
+            if i + 1 < L and (i + 1) % 10 != 0:
+                out.write(" ")
+        out.write("\n};\n")
+
+
+def main():
+    filters = []
+    for N in range(2, 21):
+        filters.append(("db%d" % N, quantize(daubechies(N))))
+    for N in range(2, 21):
+        filters.append(("sym%d" % N, quantize(symlet(N))))
+    for K, h in enumerate(coiflets(5), 1):
+        filters.append(("coif%d" % K, quantize(h)))
+
+    out = sys.stdout
+    out.write("/**\n")
+    out.write(" * @file wavelet_tables.c\n")
+    out.write(" * @brief Q14 filter banks for the Daubechies, Symlet and Coiflet families.\n")
+    out.write(" *\n")
+    out.write(" * Generated by tools/gen_wavelet_tables.py; do not edit by hand. Each bank\n")
+    out.write(" * follows the same relations as the hand-written tables in wavelet_filter.c:\n")
+    out.write(" * h1 is the quadrature mirror of h0 and g0/g1 are their time reverses.\n")
+    out.write(" */\n\n")
+    out.write('#include "wavelet_tables.h"\n\n')
+    for name, taps in filters:
+        out.write("// %s (L=%d)\n" % (name, len(taps)))
+        emit(out, name, taps)
+        out.write("\n")
+    out.write("const wavelet_kernel_set_t wavelet_family_kernels[WAVELET_FAMILY_COUNT] = {\n")
+    for i, (name, taps) in enumerate(filters):
+        out.write("    { %s_h0, %s_h1, %s_g0, %s_g1, %d }%s\n"
+                  % (name, name, name, name, len(taps), "," if i + 1 < len(filters) else ""))
+    out.write("};\n")
+
+
+if __name__ == "__main__":
+    main()
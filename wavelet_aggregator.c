@@ -0,0 +1,80 @@
+/**
+ * @file wavelet_aggregator.c
+ * @brief Multi-stream frame aggregation for lane-parallel filtering.
+ *
+ * Low-rate streams rarely have frames ready at the same moment. Instead of
+ * stepping them in lockstep, the aggregator queues whatever arrives and
+ * hands a batch to wavelet_filter_batch() once every lane is taken or the
+ * oldest frame's delay budget runs out, whichever comes first.
+ */
+
+#include "wavelet_filter.h"
+#include <string.h>
+
+int wavelet_aggregator_init(wavelet_aggregator_t* aggregator, const wavelet_config_t* config, uint16_t frame_length,
+                            uint64_t max_delay_us, wavelet_frame_callback_t deliver, void* user) {
+    if (!aggregator || !config || !deliver || frame_length == 0 || frame_length > MAX_SIGNAL_LENGTH) return -1;
+    if (wavelet_levels_for_length(frame_length, config) == 0) return -1;
+
+    memset(aggregator, 0, sizeof(*aggregator));
+    aggregator->config = *config;
+    aggregator->frame_length = frame_length;
+    aggregator->max_delay_us = max_delay_us;
+    aggregator->deliver = deliver;
+    aggregator->user = user;
+    return 0;
+}
+
+int wavelet_aggregator_flush(wavelet_aggregator_t* aggregator) {
+    if (!aggregator) return -1;
+    uint8_t count = aggregator->pending;
+    if (count == 0) return 0;
+
+    // wavelet_filter_batch() checks everything before touching a frame, so
+    // on failure the frames are handed back unfiltered.
+    int status = wavelet_filter_batch(aggregator->frames, count, aggregator->frame_length, &aggregator->config) == 0 ? 0 : -1;
+
+    // Clear the queue before delivering so callbacks may submit again.
+    uint32_t stream_ids[WAVELET_BATCH_LANES];
+    int16_t* frames[WAVELET_BATCH_LANES];
+    memcpy(stream_ids, aggregator->stream_ids, count * sizeof(uint32_t));
+    memcpy(frames, aggregator->frames, count * sizeof(int16_t*));
+    aggregator->pending = 0;
+    aggregator->batches++;
+    if (status == 0) {
+        aggregator->frames_filtered += count;
+    } else {
+        aggregator->frames_failed += count;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        aggregator->deliver(aggregator->user, stream_ids[i], frames[i], status);
+    }
+    return status == 0 ? count : -1;
+}
+
+int wavelet_aggregator_poll(wavelet_aggregator_t* aggregator, uint64_t now_us) {
+    if (!aggregator) return -1;
+    if (aggregator->pending == 0 || wavelet_aggregator_deadline(aggregator, now_us) > 0) return 0;
+    return wavelet_aggregator_flush(aggregator);
+}
+
+int wavelet_aggregator_submit(wavelet_aggregator_t* aggregator, uint32_t stream_id, int16_t* frame, uint64_t now_us) {
+    if (!aggregator || !frame) return -1;
+    // Flush always empties the queue, but never write past the lanes.
+    if (aggregator->pending >= WAVELET_BATCH_LANES) return -1;
+
+    if (aggregator->pending == 0) aggregator->oldest_us = now_us;
+    aggregator->stream_ids[aggregator->pending] = stream_id;
+    aggregator->frames[aggregator->pending] = frame;
+    aggregator->pending++;
+
+    if (aggregator->pending == WAVELET_BATCH_LANES) return wavelet_aggregator_flush(aggregator);
+    return wavelet_aggregator_poll(aggregator, now_us);
+}
+
+uint64_t wavelet_aggregator_deadline(const wavelet_aggregator_t* aggregator, uint64_t now_us) {
+    if (!aggregator || aggregator->pending == 0) return UINT64_MAX;
+    uint64_t waited = (now_us > aggregator->oldest_us) ? now_us - aggregator->oldest_us : 0;
+    return (waited >= aggregator->max_delay_us) ? 0 : aggregator->max_delay_us - waited;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file wavelet_cwt.c
+ * @brief Continuous wavelet transform (scalogram) engine.
+ *
+ * Follows Torrence and Compo, "A Practical Guide to Wavelet Analysis"
+ * (1998): W(s, n) = sum_k x^_k conj(psi^(s w_k)) e^(i w_k n), with the
+ * daughter psi^(s w) = sqrt(2 pi s) psi^_0(s w). All three families have a
+ * real frequency response, so each scale is a real weighting of the shared
+ * spectrum followed by one inverse FFT.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "wavelet_filter.h"
+#include "wavelet_fft.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#define WAVELET_CWT_PI 3.14159265358979323846
+
+typedef struct {
+    const wavelet_complex_t* spectrum;
+    const wavelet_complex_t* twiddles; // Shared table for fft_len
+    wavelet_complex_t* work;           // fft_len entries owned by this job
+    uint32_t fft_len;
+    uint16_t length;
+    const float* scales;
+    uint16_t num_scales;
+    wavelet_cwt_family_t family;
+    double parameter;
+    double norm; // Family constant in psi^_0.
+    float* scalogram_out;
+    uint16_t first_scale;
+    uint16_t scale_stride;
+} cwt_job_t;
+
+// psi^_0(s w) without the sqrt(2 pi s) daughter factor.
+static double cwt_response(const cwt_job_t* job, double sw) {
+    switch (job->family) {
+        case WAVELET_CWT_MORLET:
+            if (sw <= 0.0) return 0.0;
+            return job->norm * exp(-0.5 * (sw - job->parameter) * (sw - job->parameter));
+        case WAVELET_CWT_PAUL:
+            if (sw <= 0.0) return 0.0;
+            return job->norm * pow(sw, job->parameter) * exp(-sw);
+        case WAVELET_CWT_MEXICAN_HAT:
+        default:
+            return job->norm * sw * sw * exp(-0.5 * sw * sw);
+    }
+}
+
+static void* cwt_worker(void* arg) {
+    cwt_job_t* job = (cwt_job_t*)arg;
+    uint32_t n = job->fft_len;
+    wavelet_complex_t* work = job->work;
+
+    for (uint32_t s = job->first_scale; s < job->num_scales; s += job->scale_stride) {
+        double scale = job->scales[s];
+        double daughter = sqrt(2.0 * WAVELET_CWT_PI * scale) / n; // Also folds in the 1/N of the inverse.
+        for (uint32_t k = 0; k < n; k++) {
+            // Angular frequency of bin k; the upper half is negative.
+            double w = 2.0 * WAVELET_CWT_PI * ((k <= n / 2) ? (double)k : (double)k - n) / n;
+            double weight = daughter * cwt_response(job, scale * w);
+            work[k].re = job->spectrum[k].re * weight;
+            work[k].im = job->spectrum[k].im * weight;
+        }
+        wavelet_fft_run(work, n, job->twiddles, 1);
+
+        float* row = job->scalogram_out + (size_t)s * job->length;
+        for (uint16_t t = 0; t < job->length; t++) {
+            row[t] = (float)sqrt(work[t].re * work[t].re + work[t].im * work[t].im);
+        }
+    }
+
+    return NULL;
+}
+
+int wavelet_cwt(const int16_t* signal, uint16_t length, const float* scales, uint16_t num_scales,
+                const wavelet_cwt_config_t* config, float* scalogram_out) {
+    if (!signal || !scales || !config || !scalogram_out || length == 0 || num_scales == 0) return -1;
+    for (uint16_t s = 0; s < num_scales; s++) {
+        if (!(scales[s] > 0.0f)) return -1;
+    }
+
+    double parameter = config->parameter;
+    double norm;
+    switch (config->family) {
+        case WAVELET_CWT_MORLET:
+            if (parameter <= 0.0) parameter = 6.0;
+            norm = pow(WAVELET_CWT_PI, -0.25);
+            break;
+        case WAVELET_CWT_PAUL:
+            if (parameter <= 0.0) parameter = 4.0;
+            // 2^m / sqrt(m (2m - 1)!)
+            norm = pow(2.0, parameter) / sqrt(parameter * tgamma(2.0 * parameter));
+            break;
+        case WAVELET_CWT_MEXICAN_HAT:
+            norm = 1.0 / sqrt(tgamma(2.5));
+            break;
+        default:
+            return -1;
+    }
+
+    uint8_t threads = config->num_threads;
+    if (threads < 1) threads = 1;
+    if (threads > num_scales) threads = (uint8_t)num_scales;
+
+    // One block holds the spectrum, the twiddle table shared by every FFT
+    // of the transform, and one work row per thread, so the per-scale
+    // inverse transforms allocate nothing.
+    uint32_t n = wavelet_fft_size(length);
+    wavelet_complex_t* buffers = (wavelet_complex_t*)calloc((size_t)n + n / 2 + (size_t)threads * n,
+                                                            sizeof(wavelet_complex_t));
+    cwt_job_t* jobs = (cwt_job_t*)malloc(threads * sizeof(cwt_job_t));
+    pthread_t* handles = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    uint8_t* started = (uint8_t*)calloc(threads, sizeof(uint8_t));
+    if (!buffers || !jobs || !handles || !started) {
+        free(buffers);
+        free(jobs);
+        free(handles);
+        free(started);
+        return -1;
+    }
+    wavelet_complex_t* spectrum = buffers;
+    wavelet_complex_t* twiddles = buffers + n;
+    wavelet_complex_t* rows = twiddles + n / 2;
+
+    wavelet_fft_twiddles(twiddles, n);
+    for (uint16_t t = 0; t < length; t++) spectrum[t].re = signal[t];
+    wavelet_fft_run(spectrum, n, twiddles, 0);
+
+    // Scales are dealt round-robin so every thread gets a mix of cheap and
+    // expensive rows. Job 0 runs on the caller's thread, as do jobs whose
+    // thread could not be started.
+    for (uint8_t i = 0; i < threads; i++) {
+        cwt_job_t* job = &jobs[i];
+        job->spectrum = spectrum;
+        job->twiddles = twiddles;
+        job->work = rows + (size_t)i * n;
+        job->fft_len = n;
+        job->length = length;
+        job->scales = scales;
+        job->num_scales = num_scales;
+        job->family = config->family;
+        job->parameter = parameter;
+        job->norm = norm;
+        job->scalogram_out = scalogram_out;
+        job->first_scale = i;
+        job->scale_stride = threads;
+    }
+    for (uint8_t i = 1; i < threads; i++) {
+        started[i] = pthread_create(&handles[i], NULL, cwt_worker, &jobs[i]) == 0;
+    }
+    for (uint8_t i = 0; i < threads; i++) {
+        if (!started[i]) cwt_worker(&jobs[i]);
+    }
+
+    for (uint8_t i = 0; i < threads; i++) {
+        if (started[i]) pthread_join(handles[i], NULL);
+    }
+
+    free(buffers);
+    free(jobs);
+    free(handles);
+    free(started);
+    return 0;
+}
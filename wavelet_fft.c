@@ -0,0 +1,206 @@
+/**
+ * @file wavelet_fft.c
+ * @brief Radix-2 FFT and overlap-save periodic convolution.
+ *
+ * The transforms run in double precision. With int16 samples, Q14 taps and
+ * at most MAX_WAVELET_KERNEL_LENGTH taps the exact sums stay below 2^36, so
+ * the round-off of a few-hundred-point FFT is far below 0.5 and rounding the
+ * result recovers the integer accumulator of the direct loops bit for bit.
+ */
+
+#include "wavelet_fft.h"
+#include <stdlib.h>
+#include <math.h>
+
+#define WAVELET_FFT_PI 3.14159265358979323846
+
+// Overlap-save blocks are at most this many kernel lengths long; larger
+// blocks waste work on signals much longer than the kernel.
+#define WAVELET_FFT_BLOCK_KERNELS 8
+
+uint32_t wavelet_fft_size(uint32_t n) {
+    uint32_t size = 1;
+    while (size < n) size <<= 1;
+    return size;
+}
+
+// Only the first octant is evaluated with cos/sin; the rest follows by
+// symmetry.
+void wavelet_fft_twiddles(wavelet_complex_t* twiddles, uint32_t n) {
+    uint32_t quarter = n / 4;
+    uint32_t eighth = n / 8;
+    for (uint32_t k = 0; k <= eighth && k < n / 2; k++) {
+        double angle = 2.0 * WAVELET_FFT_PI * k / n;
+        twiddles[k].re = cos(angle);
+        twiddles[k].im = -sin(angle);
+    }
+    for (uint32_t k = eighth + 1; k <= quarter && k < n / 2; k++) {
+        twiddles[k].re = -twiddles[quarter - k].im;
+        twiddles[k].im = -twiddles[quarter - k].re;
+    }
+    for (uint32_t k = quarter + 1; k < n / 2; k++) {
+        twiddles[k].re = twiddles[k - quarter].im;
+        twiddles[k].im = -twiddles[k - quarter].re;
+    }
+}
+
+void wavelet_fft_run(wavelet_complex_t* data, uint32_t n, const wavelet_complex_t* twiddles, int inverse) {
+    for (uint32_t i = 1, j = 0; i < n; i++) {
+        uint32_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j |= bit;
+        if (i < j) {
+            wavelet_complex_t tmp = data[i];
+            data[i] = data[j];
+            data[j] = tmp;
+        }
+    }
+
+    // The inverse transform is conj(FFT(conj(x))), which keeps the
+    // butterflies free of a direction test.
+    if (inverse) {
+        for (uint32_t i = 0; i < n; i++) data[i].im = -data[i].im;
+    }
+
+    for (uint32_t i = 0; i + 1 < n; i += 2) {
+        wavelet_complex_t a = data[i];
+        wavelet_complex_t b = data[i + 1];
+        data[i].re = a.re + b.re;
+        data[i].im = a.im + b.im;
+        data[i + 1].re = a.re - b.re;
+        data[i + 1].im = a.im - b.im;
+    }
+
+    for (uint32_t len = 4; len <= n; len <<= 1) {
+        uint32_t half = len >> 1;
+        uint32_t stride = n / len;
+        for (uint32_t k = 0; k < half; k++) {
+            wavelet_complex_t w = twiddles[k * stride];
+            for (uint32_t base = k; base < n; base += len) {
+                wavelet_complex_t* a = &data[base];
+                wavelet_complex_t* b = &data[base + half];
+                double re = b->re * w.re - b->im * w.im;
+                double im = b->re * w.im + b->im * w.re;
+                b->re = a->re - re;
+                b->im = a->im - im;
+                a->re += re;
+                a->im += im;
+            }
+        }
+    }
+
+    if (inverse) {
+        for (uint32_t i = 0; i < n; i++) data[i].im = -data[i].im;
+    }
+}
+
+int wavelet_fft(wavelet_complex_t* data, uint32_t n, int inverse) {
+    if (!data || n == 0 || (n & (n - 1))) return -1;
+    if (n == 1) return 0;
+
+    wavelet_complex_t* twiddles = (wavelet_complex_t*)malloc((n / 2) * sizeof(wavelet_complex_t));
+    if (!twiddles) return -1;
+    wavelet_fft_twiddles(twiddles, n);
+    wavelet_fft_run(data, n, twiddles, inverse);
+    free(twiddles);
+    return 0;
+}
+
+// Splits the spectrum Z of a + i b (a, b real) into A and B:
+// A[k] = (Z[k] + conj Z[-k]) / 2, B[k] = (Z[k] - conj Z[-k]) / 2i.
+static void split_real_pair(const wavelet_complex_t* z, uint32_t k, uint32_t n,
+                            wavelet_complex_t* a, wavelet_complex_t* b) {
+    wavelet_complex_t mirror = z[(n - k) & (n - 1)];
+    a->re = 0.5 * (z[k].re + mirror.re);
+    a->im = 0.5 * (z[k].im - mirror.im);
+    b->re = 0.5 * (z[k].im + mirror.im);
+    b->im = -0.5 * (z[k].re - mirror.re);
+}
+
+static int32_t round_to_int32(double value) {
+    return (int32_t)floor(value + 0.5);
+}
+
+// (a * b) + (c * d) for complex a, b, c, d.
+static wavelet_complex_t mul_add(wavelet_complex_t a, wavelet_complex_t b, wavelet_complex_t c, wavelet_complex_t d) {
+    wavelet_complex_t out;
+    out.re = a.re * b.re - a.im * b.im + c.re * d.re - c.im * d.im;
+    out.im = a.re * b.im + a.im * b.re + c.re * d.im + c.im * d.re;
+    return out;
+}
+
+int wavelet_fft_convolve_2x2(const int16_t* p, const int16_t* q, uint16_t n,
+                             const int16_t* const k[4], uint8_t kernel_len,
+                             int32_t* r, int32_t* s) {
+    if (!p || !q || !k || !r || !s || n == 0 || kernel_len == 0) return -1;
+
+    uint32_t size = wavelet_fft_size((uint32_t)n + kernel_len - 1);
+    uint32_t cap = wavelet_fft_size((uint32_t)WAVELET_FFT_BLOCK_KERNELS * kernel_len);
+    if (size > cap) size = cap;
+    if (size < 4) size = 4;
+    uint32_t step = size - kernel_len + 1;
+
+    wavelet_complex_t* work = (wavelet_complex_t*)malloc((size_t)(6 * size + size / 2) * sizeof(wavelet_complex_t));
+    if (!work) return -1;
+    wavelet_complex_t* spectra = work;           // K0, K1, K2, K3
+    wavelet_complex_t* block = work + 4 * size;
+    wavelet_complex_t* packed = work + 5 * size;
+    wavelet_complex_t* twiddles = work + 6 * size;
+    wavelet_fft_twiddles(twiddles, size);
+
+    // Kernel pairs share a transform: k0 + i k1, then k2 + i k3.
+    for (int pair = 0; pair < 2; pair++) {
+        for (uint32_t t = 0; t < size; t++) {
+            packed[t].re = (t < kernel_len) ? k[2 * pair][t] : 0.0;
+            packed[t].im = (t < kernel_len) ? k[2 * pair + 1][t] : 0.0;
+        }
+        wavelet_fft_run(packed, size, twiddles, 0);
+        for (uint32_t t = 0; t < size; t++) {
+            split_real_pair(packed, t, size, &spectra[2 * pair * size + t], &spectra[(2 * pair + 1) * size + t]);
+        }
+    }
+    const wavelet_complex_t* k0 = spectra;
+    const wavelet_complex_t* k1 = spectra + size;
+    const wavelet_complex_t* k2 = spectra + 2 * size;
+    const wavelet_complex_t* k3 = spectra + 3 * size;
+
+    double scale = 1.0 / size;
+    for (uint32_t out = 0; out < n; out += step) {
+        // Block sample t holds input index out - (L - 1) + t.
+        int32_t index = ((int32_t)out - (kernel_len - 1)) % n;
+        if (index < 0) index += n;
+        for (uint32_t t = 0; t < size; t++) {
+            block[t].re = p[index];
+            block[t].im = q[index];
+            if (++index == n) index = 0;
+        }
+        wavelet_fft_run(block, size, twiddles, 0);
+
+        // R = P K0 + Q K1 and S = P K2 + Q K3, repacked as R + i S. The
+        // split reads bins t and -t, so conjugate pairs are done together.
+        for (uint32_t t = 0; t <= size / 2; t++) {
+            uint32_t u = (size - t) & (size - 1);
+            wavelet_complex_t pt, qt, pu, qu;
+            split_real_pair(block, t, size, &pt, &qt);
+            split_real_pair(block, u, size, &pu, &qu);
+            wavelet_complex_t rt = mul_add(pt, k0[t], qt, k1[t]);
+            wavelet_complex_t st = mul_add(pt, k2[t], qt, k3[t]);
+            wavelet_complex_t ru = mul_add(pu, k0[u], qu, k1[u]);
+            wavelet_complex_t su = mul_add(pu, k2[u], qu, k3[u]);
+            block[t].re = rt.re - st.im;
+            block[t].im = rt.im + st.re;
+            block[u].re = ru.re - su.im;
+            block[u].im = ru.im + su.re;
+        }
+        wavelet_fft_run(block, size, twiddles, 1);
+
+        for (uint32_t t = kernel_len - 1; t < size && out + t - (kernel_len - 1) < n; t++) {
+            uint32_t m = out + t - (kernel_len - 1);
+            r[m] = round_to_int32(block[t].re * scale);
+            s[m] = round_to_int32(block[t].im * scale);
+        }
+    }
+
+    free(work);
+    return 0;
+}
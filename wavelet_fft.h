@@ -0,0 +1,94 @@
+/**
+ * @file wavelet_fft.h
+ * @brief Internal FFT and FFT-based periodic convolution used by the wavelet library.
+ */
+
+#ifndef WAVELET_FFT_H
+#define WAVELET_FFT_H
+
+#include <stdint.h>
+
+// Full-range transforms switch to FFT convolution from this kernel length
+// on, for signals of at least WAVELET_FFT_MIN_SIGNAL_KERNELS kernel lengths.
+#define WAVELET_FFT_CROSSOVER 48
+#define WAVELET_FFT_MIN_SIGNAL_KERNELS 16
+
+/**
+ * @brief Complex sample in double precision.
+ */
+typedef struct {
+    double re;
+    double im;
+} wavelet_complex_t;
+
+/**
+ * @brief In-place iterative radix-2 FFT.
+ *
+ * The inverse transform is unscaled; divide by n to invert a forward transform.
+ *
+ * @param[in,out] data The n samples to transform.
+ * @param[in] n The transform length (a power of two).
+ * @param[in] inverse Non-zero for the inverse (positive exponent) transform.
+ * @return 0 on success, -1 if n is not a power of two.
+ */
+int wavelet_fft(wavelet_complex_t* data, uint32_t n, int inverse);
+
+/**
+ * @brief Returns the smallest power of two that is >= n.
+ */
+uint32_t wavelet_fft_size(uint32_t n);
+
+/**
+ * @brief Fills the twiddle table of an n-point FFT.
+ *
+ * twiddles[k] = exp(-2 pi i k / n) for k < n / 2. Callers running many
+ * transforms of one length build the table once and use wavelet_fft_run().
+ *
+ * @param[out] twiddles Buffer of n / 2 entries.
+ * @param[in] n The transform length (a power of two, at least 2).
+ */
+void wavelet_fft_twiddles(wavelet_complex_t* twiddles, uint32_t n);
+
+/**
+ * @brief wavelet_fft() with a twiddle table from wavelet_fft_twiddles().
+ *
+ * Allocates nothing, so it is safe to call from many threads that share
+ * one table.
+ *
+ * @param[in,out] data The n samples to transform.
+ * @param[in] n The transform length (a power of two, at least 2).
+ * @param[in] twiddles The table built for n.
+ * @param[in] inverse Non-zero for the inverse (positive exponent) transform.
+ */
+void wavelet_fft_run(wavelet_complex_t* data, uint32_t n, const wavelet_complex_t* twiddles, int inverse);
+
+/**
+ * @brief Two-input, two-output periodic convolution with exact integer results.
+ *
+ * Computes, for m in [0, n),
+ *   r[m] = sum_j p[(m - j) mod n] * k[0][j] + q[(m - j) mod n] * k[1][j]
+ *   s[m] = sum_j p[(m - j) mod n] * k[2][j] + q[(m - j) mod n] * k[3][j]
+ * as the exact 32-bit accumulators a direct loop would produce. This is the
+ * shape of one polyphase analysis or synthesis step: the two phases of the
+ * input (or the two bands) in, the two bands (or output phases) out.
+ *
+ * p and q are packed as the real and imaginary parts of one complex
+ * sequence, as are r and s, so each overlap-save block costs one forward
+ * and one inverse FFT. Blocks of FFT length P >= 2 * kernel_len each yield
+ * P - kernel_len + 1 outputs; the first kernel_len - 1 samples of a block
+ * are the wrapped history.
+ *
+ * @param[in] p The first input sequence of length n.
+ * @param[in] q The second input sequence of length n.
+ * @param[in] n The period of the inputs and outputs.
+ * @param[in] k The four kernels, each kernel_len taps.
+ * @param[in] kernel_len The number of taps in each kernel.
+ * @param[out] r The first output sequence of length n.
+ * @param[out] s The second output sequence of length n.
+ * @return 0 on success, -1 on invalid arguments or allocation failure.
+ */
+int wavelet_fft_convolve_2x2(const int16_t* p, const int16_t* q, uint16_t n,
+                             const int16_t* const k[4], uint8_t kernel_len,
+                             int32_t* r, int32_t* s);
+
+#endif // WAVELET_FFT_H
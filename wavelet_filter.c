@@ -8,11 +8,23 @@
  */
 
 #include "wavelet_filter.h"
+#include "wavelet_tables.h"
+#include "wavelet_fft.h"
+#include "wavelet_long.h"
 #include <string.h>
 #include <stdlib.h> // For abs(), malloc, free
+#include <math.h>
 
 // Q14 fixed-point coefficients for various wavelets
 // To convert float `c` to Q14: (int16_t)(c * (1 << 14))
+#define KERNEL_Q 14
+
+// THRESHOLD_SPIKE patches the signal directly while at most length / 16
+// detail coefficients are outliers; beyond that a full reconstruction is cheaper.
+#define WAVELET_SPIKE_PATCH_DIVISOR 16
+
+// Upper bound on wavelet_config_t::neighbourhood_radius.
+#define WAVELET_MAX_NEIGHBOURHOOD_RADIUS 16
 
 // Haar Wavelet (L=2)
 // Analysis filters
@@ -32,11 +44,24 @@ static const int16_t db4_g1[] = {-7913, 13705, -3672, -2120}; // High-pass recon
 
 // Daubechies 6 (db6) Wavelet (L=6)
 // Analysis filters
-static const int16_t db6_h0[] = {3853, 9345, 5326, -1565, -990, 408}; // Low-pass
-static const int16_t db6_h1[] = {408, 990, -1565, -5326, 9345, -3853}; // High-pass (derived from h0)
+static const int16_t db6_h0[] = {5450, 13220, 7535, -2212, -1400, 577}; // Low-pass
+static const int16_t db6_h1[] = {577, 1400, -2212, -7535, 13220, -5450}; // High-pass (derived from h0)
 // Synthesis filters
-static const int16_t db6_g0[] = {408, -990, -1565, 5326, 9345, 3853}; // Low-pass reconstruction (time-reversed h0)
-static const int16_t db6_g1[] = {-3853, 9345, -5326, -1565, 990, 408}; // High-pass reconstruction (time-reversed h1)
+static const int16_t db6_g0[] = {577, -1400, -2212, 7535, 13220, 5450}; // Low-pass reconstruction (time-reversed h0)
+static const int16_t db6_g1[] = {-5450, 13220, -7535, -2212, 1400, 577}; // High-pass reconstruction (time-reversed h1)
+
+// Filter banks added at runtime with wavelet_register_custom(). Handles are
+// WAVELET_CUSTOM_FIRST + slot.
+typedef struct {
+    int16_t h0[MAX_WAVELET_KERNEL_LENGTH];
+    int16_t h1[MAX_WAVELET_KERNEL_LENGTH];
+    int16_t g0[MAX_WAVELET_KERNEL_LENGTH];
+    int16_t g1[MAX_WAVELET_KERNEL_LENGTH];
+    uint8_t len;
+} custom_wavelet_t;
+
+static custom_wavelet_t custom_wavelets[WAVELET_MAX_CUSTOM];
+static uint8_t custom_wavelet_count = 0;
 
 static void get_wavelet_coeffs(
     wavelet_type_t wavelet,
@@ -44,6 +69,32 @@ static void get_wavelet_coeffs(
     const int16_t** g0_kernel, const int16_t** g1_kernel,
     uint8_t* len) {
 
+    // Callers that only need the synthesis pair may pass NULL for the rest.
+    const int16_t* unused_h0;
+    const int16_t* unused_h1;
+    if (!h0_kernel) h0_kernel = &unused_h0;
+    if (!h1_kernel) h1_kernel = &unused_h1;
+
+    if (wavelet >= WAVELET_CUSTOM_FIRST && wavelet < WAVELET_CUSTOM_FIRST + custom_wavelet_count) {
+        const custom_wavelet_t* custom = &custom_wavelets[wavelet - WAVELET_CUSTOM_FIRST];
+        *h0_kernel = custom->h0;
+        *h1_kernel = custom->h1;
+        *g0_kernel = custom->g0;
+        *g1_kernel = custom->g1;
+        *len = custom->len;
+        return;
+    }
+
+    if (wavelet >= WAVELET_FAMILY_FIRST && wavelet <= WAVELET_FAMILY_LAST) {
+        const wavelet_kernel_set_t* bank = &wavelet_family_kernels[wavelet - WAVELET_FAMILY_FIRST];
+        *h0_kernel = bank->h0;
+        *h1_kernel = bank->h1;
+        *g0_kernel = bank->g0;
+        *g1_kernel = bank->g1;
+        *len = bank->len;
+        return;
+    }
+
     switch (wavelet) {
         case WAVELET_DB6:
             *h0_kernel = db6_h0;
@@ -70,6 +121,76 @@ static void get_wavelet_coeffs(
     }
 }
 
+static int16_t saturate_int16(int32_t value) {
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+    return (int16_t)value;
+}
+
+// Rounds a Q14 accumulator back to sample units.
+static int16_t round_kernel_acc(int32_t acc) {
+    return saturate_int16((acc + (1 << (KERNEL_Q - 1))) >> KERNEL_Q);
+}
+
+wavelet_type_t wavelet_register_custom(const int16_t* h0, uint8_t len, uint16_t q_format) {
+    if (!h0 || len < 2 || (len & 1) || len > MAX_WAVELET_KERNEL_LENGTH || q_format > 15) return WAVELET_INVALID;
+    if (custom_wavelet_count >= WAVELET_MAX_CUSTOM) return WAVELET_INVALID;
+
+    // Bring the taps to the Q14 kernel precision used by every transform.
+    int16_t taps[MAX_WAVELET_KERNEL_LENGTH];
+    for (uint8_t k = 0; k < len; k++) {
+        int32_t tap = h0[k];
+        if (q_format > KERNEL_Q) {
+            int shift = q_format - KERNEL_Q;
+            tap = (tap + (1 << (shift - 1))) >> shift;
+        } else {
+            tap *= 1 << (KERNEL_Q - q_format);
+        }
+        if (tap > INT16_MAX || tap < INT16_MIN) return WAVELET_INVALID;
+        taps[k] = (int16_t)tap;
+    }
+
+    // Orthonormality: sum_k h0[k] h0[k + 2m] must be 1 for m = 0 and 0 for
+    // every other even shift, and the DC gain must be sqrt(2). Quantizing to
+    // Q14 perturbs each sum by up to about len * 2^-14, which the tolerance
+    // allows for.
+    int64_t tolerance = (int64_t)len << (2 * KERNEL_Q - 13);
+    for (uint8_t shift = 0; shift < len; shift += 2) {
+        int64_t inner = 0;
+        for (uint8_t k = 0; k + shift < len; k++) {
+            inner += (int32_t)taps[k] * taps[k + shift];
+        }
+        int64_t expected = (shift == 0) ? ((int64_t)1 << (2 * KERNEL_Q)) : 0;
+        if (llabs(inner - expected) > tolerance) return WAVELET_INVALID;
+    }
+    int32_t dc = 0;
+    for (uint8_t k = 0; k < len; k++) dc += taps[k];
+    if (abs(dc - 23170) > len) return WAVELET_INVALID; // sqrt(2) in Q14
+
+    // Every kernel sums up to L sample * tap products in 32 bits and rounds
+    // once, so a full-scale input must not overflow that sum. This is the
+    // bound tools/gen_wavelet_tables.py enforces for the built-in tables.
+    int32_t gain = 0;
+    for (uint8_t k = 0; k < len; k++) gain += abs(taps[k]);
+    if ((int64_t)gain * 32768 >= ((int64_t)1 << 31)) return WAVELET_INVALID;
+
+    // Quadrature mirror high-pass and time-reversed synthesis filters, the
+    // same relations the built-in tables follow.
+    custom_wavelet_t* custom = &custom_wavelets[custom_wavelet_count];
+    for (uint8_t k = 0; k < len; k++) {
+        int16_t mirrored = taps[len - 1 - k];
+        custom->h0[k] = taps[k];
+        custom->h1[k] = (k & 1) ? (int16_t)-mirrored : mirrored;
+        custom->g0[k] = mirrored;
+    }
+    for (uint8_t k = 0; k < len; k++) {
+        custom->g1[k] = custom->h1[len - 1 - k];
+    }
+    custom->len = len;
+
+    return (wavelet_type_t)(WAVELET_CUSTOM_FIRST + custom_wavelet_count++);
+}
+
 void wavelet_get_default_config(wavelet_config_t* config) {
     if (!config) return;
     config->wavelet = WAVELET_DB4;
@@ -77,23 +198,224 @@ void wavelet_get_default_config(wavelet_config_t* config) {
     config->decomposition_levels = 6;
     config->threshold_value = 100;
     config->q_format = 14;
+    for (uint8_t band = 0; band <= MAX_DECOMPOSITION_LEVELS; band++) {
+        config->band_mode[band] = WAVELET_BAND_DEFAULT;
+        config->band_gain[band] = 1 << KERNEL_Q;
+        config->level_threshold[band].threshold_type = config->threshold_type;
+        config->level_threshold[band].threshold_value = config->threshold_value;
+    }
+    config->per_level_thresholds = 0;
+    config->neighbourhood_radius = 1;
 }
 
-void dwt(const int16_t* input_signal, int16_t* approx_coeffs, int16_t* detail_coeffs, uint16_t n, wavelet_type_t wavelet, uint16_t q_format) {
-    if (n < 2) return;
+static uint16_t wrap_index(int32_t index, uint16_t n) {
+    int32_t wrapped = index % n;
+    return (uint16_t)((wrapped < 0) ? wrapped + n : wrapped);
+}
 
-    const int16_t* h0_kernel = NULL;
-    const int16_t* h1_kernel = NULL;
-    const int16_t* g0_kernel = NULL;
-    const int16_t* g1_kernel = NULL;
-    uint8_t kernel_len = 0;
-    get_wavelet_coeffs(wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+// Long kernels on full-range spans go through overlap-save FFT convolution,
+// which returns the same accumulators as the direct loops. The kernel
+// spectra and twiddles are set up per call, so the signal must also be long
+// enough to amortize them.
+static int uses_fft(uint8_t kernel_len, uint16_t n) {
+    return kernel_len >= WAVELET_FFT_CROSSOVER && n >= (uint32_t)WAVELET_FFT_MIN_SIGNAL_KERNELS * kernel_len;
+}
 
-    if (n < kernel_len) return;
+// dwt_span() over the whole signal in polyphase form. With xe[k] = x[2k]
+// and xo[k] = x[2k + 1], a[i] = sum_t xe[i - t] h0[2t] + xo[i - t] h0[2t - 1]
+// (the odd phase is delayed by one coefficient), and likewise for d with h1.
+static int dwt_fft(const int16_t* input_signal, int16_t* approx_coeffs, int16_t* detail_coeffs, uint16_t n,
+                   const int16_t* h0_kernel, const int16_t* h1_kernel, uint8_t kernel_len) {
+    uint16_t half = n >> 1;
+    uint8_t taps = (kernel_len >> 1) + 1;
+    int16_t phases[4][MAX_WAVELET_KERNEL_LENGTH / 2 + 1];
+    for (uint8_t t = 0; t < taps; t++) {
+        phases[0][t] = (2 * t < kernel_len) ? h0_kernel[2 * t] : 0;
+        phases[1][t] = (t > 0) ? h0_kernel[2 * t - 1] : 0;
+        phases[2][t] = (2 * t < kernel_len) ? h1_kernel[2 * t] : 0;
+        phases[3][t] = (t > 0) ? h1_kernel[2 * t - 1] : 0;
+    }
+    const int16_t* const kernels[4] = { phases[0], phases[1], phases[2], phases[3] };
+
+    int16_t* samples = (int16_t*)calloc(n, sizeof(int16_t));
+    int32_t* acc = (int32_t*)malloc((size_t)n * sizeof(int32_t));
+    if (!samples || !acc) {
+        free(samples);
+        free(acc);
+        return -1;
+    }
+    for (uint16_t k = 0; k < half; k++) {
+        samples[k] = input_signal[2 * k];
+        samples[half + k] = input_signal[2 * k + 1];
+    }
+    int status = wavelet_fft_convolve_2x2(samples, samples + half, half, kernels, taps, acc, acc + half);
+    if (status == 0) {
+        for (uint16_t i = 0; i < half; i++) {
+            if (approx_coeffs) approx_coeffs[i] = round_kernel_acc(acc[i]);
+            if (detail_coeffs) detail_coeffs[i] = round_kernel_acc(acc[half + i]);
+        }
+    }
+    free(samples);
+    free(acc);
+    return status;
+}
+
+// idwt_span() over the whole signal in polyphase form. Sample m gathers
+// y[m + L - 1], where y[2k] = sum_t a[k - t] g0[2t] + d[k - t] g1[2t] and
+// y[2k + 1] uses the odd taps instead.
+static int idwt_fft(const int16_t* approx_coeffs, const int16_t* detail_coeffs, int16_t* output_signal, uint16_t output_len,
+                    const int16_t* g0_kernel, const int16_t* g1_kernel, uint8_t kernel_len) {
+    uint16_t half = output_len >> 1;
+    uint8_t taps = kernel_len >> 1;
+    int16_t phases[4][MAX_WAVELET_KERNEL_LENGTH / 2];
+    for (uint8_t t = 0; t < taps; t++) {
+        phases[0][t] = g0_kernel[2 * t];
+        phases[1][t] = g1_kernel[2 * t];
+        phases[2][t] = g0_kernel[2 * t + 1];
+        phases[3][t] = g1_kernel[2 * t + 1];
+    }
+    const int16_t* const kernels[4] = { phases[0], phases[1], phases[2], phases[3] };
+
+    // A NULL band convolves as zeros.
+    int16_t* zeros = NULL;
+    if (!approx_coeffs || !detail_coeffs) {
+        zeros = (int16_t*)calloc(half, sizeof(int16_t));
+        if (!zeros) return -1;
+    }
+    int32_t* acc = (int32_t*)malloc((size_t)output_len * sizeof(int32_t));
+    if (!acc) {
+        free(zeros);
+        return -1;
+    }
+    int status = wavelet_fft_convolve_2x2(approx_coeffs ? approx_coeffs : zeros, detail_coeffs ? detail_coeffs : zeros,
+                                          half, kernels, taps, acc, acc + half);
+    if (status == 0) {
+        for (uint16_t m = 0; m < output_len; m++) {
+            uint16_t y = (uint16_t)((m + kernel_len - 1) % output_len);
+            output_signal[m] = round_kernel_acc(acc[(y & 1) * half + (y >> 1)]);
+        }
+    }
+    free(zeros);
+    free(acc);
+    return status;
+}
+
+// Running statistics for one detail band, updated as coefficients are produced.
+typedef struct {
+    int64_t energy;
+    int64_t abs_sum;
+    double weighted_log_energy; // sum of c^2 * ln(c^2), for the entropy term
+    uint32_t zero_crossings;
+    int32_t max_abs;
+    int16_t last_nonzero;
+} band_accumulator_t;
+
+// Folds one detail coefficient into `acc`; coefficients must arrive in order.
+static inline void band_accumulate(band_accumulator_t* acc, int32_t d) {
+    int32_t mag = (d < 0) ? -d : d;
+    int64_t sq = (int64_t)d * d;
+    acc->energy += sq;
+    acc->abs_sum += mag;
+    if (sq > 0) acc->weighted_log_energy += (double)sq * log((double)sq);
+    if (mag > acc->max_abs) acc->max_abs = mag;
+    if (d != 0) {
+        if ((d < 0) != (acc->last_nonzero < 0) && acc->last_nonzero != 0) acc->zero_crossings++;
+        acc->last_nonzero = (int16_t)d;
+    }
+}
+
+// Analysis outputs first .. first + count - 1 whose taps do not wrap
+// (2i >= L - 1), read straight from the input without modulo arithmetic.
+// Inlined with a constant kernel_len from dwt_interior() so each common
+// length gets a fully unrolled loop. A non-NULL `features` receives every
+// detail coefficient as it is computed, whether or not it is stored.
+static inline void dwt_interior_len(const int16_t* input_signal, int16_t* approx_coeffs, int16_t* detail_coeffs,
+                                    const int16_t* h0_kernel, const int16_t* h1_kernel, uint8_t kernel_len,
+                                    uint16_t first, uint16_t count, band_accumulator_t* features) {
+    for (uint16_t i = first; i < first + count; i++) {
+        const int16_t* x = input_signal + 2 * i;
+        if (approx_coeffs) {
+            int32_t acc = 0;
+            for (uint8_t j = 0; j < kernel_len; j++) acc += (int32_t)x[-j] * h0_kernel[j];
+            approx_coeffs[i] = round_kernel_acc(acc);
+        }
+        if (detail_coeffs || features) {
+            int32_t acc = 0;
+            for (uint8_t j = 0; j < kernel_len; j++) acc += (int32_t)x[-j] * h1_kernel[j];
+            int16_t d = round_kernel_acc(acc);
+            if (detail_coeffs) detail_coeffs[i] = d;
+            if (features) band_accumulate(features, d);
+        }
+    }
+}
+
+// Every built-in length (the generated db/sym banks go up to 40 taps) gets
+// its own case; only custom banks above that use the generic loop.
+#define WAVELET_INTERIOR_CASE(L, call) case L: call(L); break;
+#define WAVELET_INTERIOR_CASES(call) \
+    WAVELET_INTERIOR_CASE(2, call) WAVELET_INTERIOR_CASE(4, call) WAVELET_INTERIOR_CASE(6, call) \
+    WAVELET_INTERIOR_CASE(8, call) WAVELET_INTERIOR_CASE(10, call) WAVELET_INTERIOR_CASE(12, call) \
+    WAVELET_INTERIOR_CASE(14, call) WAVELET_INTERIOR_CASE(16, call) WAVELET_INTERIOR_CASE(18, call) \
+    WAVELET_INTERIOR_CASE(20, call) WAVELET_INTERIOR_CASE(22, call) WAVELET_INTERIOR_CASE(24, call) \
+    WAVELET_INTERIOR_CASE(26, call) WAVELET_INTERIOR_CASE(28, call) WAVELET_INTERIOR_CASE(30, call) \
+    WAVELET_INTERIOR_CASE(32, call) WAVELET_INTERIOR_CASE(34, call) WAVELET_INTERIOR_CASE(36, call) \
+    WAVELET_INTERIOR_CASE(38, call) WAVELET_INTERIOR_CASE(40, call)
+
+static void dwt_interior(const int16_t* input_signal, int16_t* approx_coeffs, int16_t* detail_coeffs,
+                         const int16_t* h0_kernel, const int16_t* h1_kernel, uint8_t kernel_len,
+                         uint16_t first, uint16_t count) {
+#define DWT_INTERIOR(L) dwt_interior_len(input_signal, approx_coeffs, detail_coeffs, h0_kernel, h1_kernel, L, first, count, NULL)
+    switch (kernel_len) {
+        WAVELET_INTERIOR_CASES(DWT_INTERIOR)
+        default: DWT_INTERIOR(kernel_len); break;
+    }
+#undef DWT_INTERIOR
+}
+
+// dwt_interior() with the detail coefficients also folded into `features`.
+// Kept separate so the plain kernels carry no accumulator test.
+static void dwt_interior_features(const int16_t* input_signal, int16_t* approx_coeffs, int16_t* detail_coeffs,
+                                  const int16_t* h0_kernel, const int16_t* h1_kernel, uint8_t kernel_len,
+                                  uint16_t first, uint16_t count, band_accumulator_t* features) {
+#define DWT_INTERIOR(L) dwt_interior_len(input_signal, approx_coeffs, detail_coeffs, h0_kernel, h1_kernel, L, first, count, features)
+    switch (kernel_len) {
+        WAVELET_INTERIOR_CASES(DWT_INTERIOR)
+        default: DWT_INTERIOR(kernel_len); break;
+    }
+#undef DWT_INTERIOR
+}
 
+// Computes analysis outputs start .. start + count - 1 (indices wrap modulo
+// n / 2). dwt() is the full-range case; incremental updates use sub-spans.
+// Either output may be NULL, in which case its filter is not evaluated.
+// Only the first (L - 1) / 2 outputs wrap around the signal start; the rest
+// of the span is handed to dwt_interior() in runs. A non-NULL `features`
+// accumulates the detail coefficients in output order as they are computed.
+static void dwt_span_features(const int16_t* input_signal, int16_t* approx_coeffs, int16_t* detail_coeffs, uint16_t n,
+                              const int16_t* h0_kernel, const int16_t* h1_kernel, uint8_t kernel_len,
+                              int32_t start, uint16_t count, band_accumulator_t* features) {
     uint16_t half = n >> 1;
 
-    for (uint16_t i = 0; i < half; i++) {
+    if (!features && start == 0 && count == half && uses_fft(kernel_len, n) &&
+        dwt_fft(input_signal, approx_coeffs, detail_coeffs, n, h0_kernel, h1_kernel, kernel_len) == 0) {
+        return;
+    }
+
+    uint16_t c = 0;
+    while (c < count) {
+        uint16_t i = wrap_index(start + c, half);
+        if (2 * i >= kernel_len - 1) {
+            uint16_t run = half - i;
+            if (run > count - c) run = count - c;
+            if (features) {
+                dwt_interior_features(input_signal, approx_coeffs, detail_coeffs, h0_kernel, h1_kernel, kernel_len,
+                                      i, run, features);
+            } else {
+                dwt_interior(input_signal, approx_coeffs, detail_coeffs, h0_kernel, h1_kernel, kernel_len, i, run);
+            }
+            c += run;
+            continue;
+        }
         int32_t approx_val = 0;
         int32_t detail_val = 0;
         for (uint8_t j = 0; j < kernel_len; j++) {
@@ -101,12 +423,120 @@ void dwt(const int16_t* input_signal, int16_t* approx_coeffs, int16_t* detail_co
             approx_val += (int32_t)input_signal[input_idx] * h0_kernel[j];
             detail_val += (int32_t)input_signal[input_idx] * h1_kernel[j];
         }
-        approx_coeffs[i] = (int16_t)(approx_val >> q_format);
-        detail_coeffs[i] = (int16_t)(detail_val >> q_format);
+        if (approx_coeffs) approx_coeffs[i] = round_kernel_acc(approx_val);
+        if (detail_coeffs) detail_coeffs[i] = round_kernel_acc(detail_val);
+        if (features) band_accumulate(features, round_kernel_acc(detail_val));
+        c++;
+    }
+}
+
+static void dwt_span(const int16_t* input_signal, int16_t* approx_coeffs, int16_t* detail_coeffs, uint16_t n,
+                     const int16_t* h0_kernel, const int16_t* h1_kernel, uint8_t kernel_len,
+                     int32_t start, uint16_t count) {
+    dwt_span_features(input_signal, approx_coeffs, detail_coeffs, n, h0_kernel, h1_kernel, kernel_len,
+                      start, count, NULL);
+}
+
+// Synthesis outputs first .. first + count - 1 whose taps do not wrap
+// (m + L - 1 < output_len). Output m only meets taps of parity (m + L - 1) & 1,
+// so the kernels are split into their even and odd phases and each output
+// runs one contiguous phase against consecutive coefficients.
+static inline void idwt_interior_len(const int16_t* approx_coeffs, const int16_t* detail_coeffs, int16_t* output_signal,
+                                     const int16_t* g0_phase, const int16_t* g1_phase, uint8_t kernel_len,
+                                     uint16_t first, uint16_t count) {
+    uint8_t taps = kernel_len >> 1;
+    for (uint16_t m = first; m < first + count; m++) {
+        uint8_t parity = (m + kernel_len - 1) & 1;
+        const int16_t* p0 = g0_phase + parity * taps;
+        const int16_t* p1 = g1_phase + parity * taps;
+        uint16_t i0 = (uint16_t)((m + kernel_len - 1 - parity) >> 1);
+        int32_t acc = 0;
+        if (approx_coeffs) {
+            for (uint8_t t = 0; t < taps; t++) acc += (int32_t)approx_coeffs[i0 - t] * p0[t];
+        }
+        if (detail_coeffs) {
+            for (uint8_t t = 0; t < taps; t++) acc += (int32_t)detail_coeffs[i0 - t] * p1[t];
+        }
+        output_signal[m] = round_kernel_acc(acc);
+    }
+}
+
+static void idwt_interior(const int16_t* approx_coeffs, const int16_t* detail_coeffs, int16_t* output_signal,
+                          const int16_t* g0_kernel, const int16_t* g1_kernel, uint8_t kernel_len,
+                          uint16_t first, uint16_t count) {
+    // Polyphase split: even taps first, then odd taps.
+    int16_t g0_phase[MAX_WAVELET_KERNEL_LENGTH];
+    int16_t g1_phase[MAX_WAVELET_KERNEL_LENGTH];
+    uint8_t taps = kernel_len >> 1;
+    for (uint8_t t = 0; t < taps; t++) {
+        g0_phase[t] = g0_kernel[2 * t];
+        g0_phase[taps + t] = g0_kernel[2 * t + 1];
+        g1_phase[t] = g1_kernel[2 * t];
+        g1_phase[taps + t] = g1_kernel[2 * t + 1];
+    }
+
+#define IDWT_INTERIOR(L) idwt_interior_len(approx_coeffs, detail_coeffs, output_signal, g0_phase, g1_phase, L, first, count)
+    switch (kernel_len) {
+        WAVELET_INTERIOR_CASES(IDWT_INTERIOR)
+        default: IDWT_INTERIOR(kernel_len); break;
+    }
+#undef IDWT_INTERIOR
+}
+
+// Computes synthesis outputs start .. start + count - 1 (indices wrap modulo
+// output_len). Synthesis is the transpose of dwt(): coefficient i with tap j
+// lands on sample 2i + j - (L - 1). Gathering per output sample keeps every
+// sum in 32 bits and rounds it once. A NULL band is treated as all zeros.
+// Outputs below output_len - (L - 1) never wrap and go to idwt_interior().
+static void idwt_span(const int16_t* approx_coeffs, const int16_t* detail_coeffs, int16_t* output_signal, uint16_t output_len,
+                      const int16_t* g0_kernel, const int16_t* g1_kernel, uint8_t kernel_len,
+                      int32_t start, uint16_t count) {
+    if (start == 0 && count == output_len && uses_fft(kernel_len, output_len) &&
+        idwt_fft(approx_coeffs, detail_coeffs, output_signal, output_len, g0_kernel, g1_kernel, kernel_len) == 0) {
+        return;
+    }
+
+    uint16_t interior_end = (output_len >= kernel_len) ? (uint16_t)(output_len - kernel_len + 1) : 0;
+
+    uint16_t c = 0;
+    while (c < count) {
+        uint16_t m = wrap_index(start + c, output_len);
+        if (m < interior_end) {
+            uint16_t run = interior_end - m;
+            if (run > count - c) run = count - c;
+            idwt_interior(approx_coeffs, detail_coeffs, output_signal, g0_kernel, g1_kernel, kernel_len, m, run);
+            c += run;
+            continue;
+        }
+        int32_t acc = 0;
+        for (uint8_t j = (m + kernel_len - 1) & 1; j < kernel_len; j += 2) {
+            uint16_t i = (uint16_t)(((m + kernel_len - 1 - j) % output_len) >> 1);
+            if (approx_coeffs) acc += (int32_t)approx_coeffs[i] * g0_kernel[j];
+            if (detail_coeffs) acc += (int32_t)detail_coeffs[i] * g1_kernel[j];
+        }
+        output_signal[m] = round_kernel_acc(acc);
+        c++;
     }
 }
 
+void dwt(const int16_t* input_signal, int16_t* approx_coeffs, int16_t* detail_coeffs, uint16_t n, wavelet_type_t wavelet, uint16_t q_format) {
+    (void)q_format; // Kernels are Q14; the transform is linear in the sample format.
+    if (n < 2) return;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    if (n < kernel_len) return;
+
+    dwt_span(input_signal, approx_coeffs, detail_coeffs, n, h0_kernel, h1_kernel, kernel_len, 0, n >> 1);
+}
+
 void idwt(const int16_t* approx_coeffs, const int16_t* detail_coeffs, int16_t* output_signal, uint16_t n_input_coeffs, wavelet_type_t wavelet, uint16_t q_format) {
+    (void)q_format;
     if (n_input_coeffs < 1) return;
 
     const int16_t* g0_kernel = NULL;
@@ -117,30 +547,110 @@ void idwt(const int16_t* approx_coeffs, const int16_t* detail_coeffs, int16_t* o
     if (n_input_coeffs < (kernel_len >> 1)) return;
 
     uint16_t output_len = n_input_coeffs * 2;
+    idwt_span(approx_coeffs, detail_coeffs, output_signal, output_len, g0_kernel, g1_kernel, kernel_len, 0, output_len);
+}
 
-    memset(output_signal, 0, output_len * sizeof(int16_t));
+// Half-open sample range in unwrapped coordinates; indices are reduced
+// modulo the band length only when the range is evaluated.
+typedef struct {
+    int32_t start;
+    int32_t end;
+} sample_span_t;
 
-    for (uint16_t i = 0; i < n_input_coeffs; i++) {
-        for (uint8_t j = 0; j < kernel_len; j++) {
-            int output_idx = (2 * i - j + output_len) % output_len;
-            output_signal[output_idx] += (int16_t)(((int32_t)approx_coeffs[i] * g0_kernel[j]) >> q_format);
-        }
+static int32_t floor_half(int32_t v) {
+    return (v >= 0) ? (v / 2) : -((1 - v) / 2);
+}
+
+static sample_span_t clamp_span(sample_span_t span, uint16_t n) {
+    if (span.end - span.start >= n) {
+        span.start = 0;
+        span.end = n;
     }
+    return span;
+}
 
-    for (uint16_t i = 0; i < n_input_coeffs; i++) {
-        for (uint8_t j = 0; j < kernel_len; j++) {
-            int output_idx = (2 * i - j + output_len) % output_len;
-            output_signal[output_idx] += (int16_t)(((int32_t)detail_coeffs[i] * g1_kernel[j]) >> q_format);
+// Coefficients of the next level whose h0/h1 taps read a changed input.
+static sample_span_t analysis_cone(sample_span_t changed, uint8_t kernel_len, uint16_t half) {
+    sample_span_t out;
+    out.start = floor_half(changed.start + 1);
+    out.end = floor_half(changed.end + kernel_len - 2) + 1;
+    return clamp_span(out, half);
+}
+
+// Samples of the finer level that a changed coefficient contributes to.
+static sample_span_t synthesis_cone(sample_span_t changed, uint8_t kernel_len, uint16_t output_len) {
+    sample_span_t out;
+    out.start = 2 * changed.start - (kernel_len - 1);
+    out.end = 2 * changed.end - 1;
+    return clamp_span(out, output_len);
+}
+
+static sample_span_t span_hull(sample_span_t a, sample_span_t b, uint16_t n) {
+    sample_span_t out;
+    out.start = (a.start < b.start) ? a.start : b.start;
+    out.end = (a.end > b.end) ? a.end : b.end;
+    return clamp_span(out, n);
+}
+
+static int is_neighbourhood_threshold(threshold_type_t type) {
+    return type == THRESHOLD_BLOCK || type == THRESHOLD_BLOCK_JS;
+}
+
+// Block thresholding of out[start .. start + count) (indices wrap modulo n)
+// from the unmodified coefficients in `raw`. The energy of the 2r + 1
+// neighbourhood is carried along as a sliding sum, one add and one subtract
+// per coefficient, so the cost is O(count + r) regardless of the radius.
+// A neighbourhood whose mean energy reaches threshold^2 keeps its centre
+// coefficient (THRESHOLD_BLOCK) or shrinks it by 1 - window * T^2 / energy
+// (THRESHOLD_BLOCK_JS, James-Stein); otherwise the coefficient is zeroed.
+static void threshold_neighbourhood_span(const int16_t* raw, int16_t* out, uint16_t n, int32_t start, uint16_t count,
+                                         threshold_type_t type, int16_t threshold, uint8_t radius) {
+    if (radius > WAVELET_MAX_NEIGHBOURHOOD_RADIUS) radius = WAVELET_MAX_NEIGHBOURHOOD_RADIUS;
+    if (2 * radius + 1 > n) radius = (uint8_t)((n - 1) / 2);
+    int64_t limit = (int64_t)threshold * threshold * (2 * radius + 1);
+
+    int64_t energy = 0;
+    for (int32_t j = start - radius; j <= start + radius; j++) {
+        int32_t v = raw[wrap_index(j, n)];
+        energy += v * v;
+    }
+
+    if (type == THRESHOLD_BLOCK) {
+        for (uint16_t c = 0; c < count; c++) {
+            int32_t i = start + c;
+            uint16_t idx = wrap_index(i, n);
+            out[idx] = (energy >= limit) ? raw[idx] : 0;
+            int32_t enter = raw[wrap_index(i + radius + 1, n)];
+            int32_t leave = raw[wrap_index(i - radius, n)];
+            energy += enter * enter - leave * leave;
+        }
+    } else {
+        for (uint16_t c = 0; c < count; c++) {
+            int32_t i = start + c;
+            uint16_t idx = wrap_index(i, n);
+            out[idx] = (energy > limit) ? (int16_t)(((int64_t)raw[idx] * (energy - limit)) / energy) : 0;
+            int32_t enter = raw[wrap_index(i + radius + 1, n)];
+            int32_t leave = raw[wrap_index(i - radius, n)];
+            energy += enter * enter - leave * leave;
         }
     }
 }
 
-void apply_thresholding(int16_t* coeffs, uint16_t length, const wavelet_config_t* config) {
-    if (!coeffs || !config || length == 0) return;
-
-    int16_t threshold = config->threshold_value;
+// Thresholding kernel with the strategy and threshold fixed for the whole
+// band, so each inner loop is a single branch-free compare pattern whether
+// the parameters come from the global or the per-level configuration.
+static void threshold_band(int16_t* coeffs, uint16_t length, threshold_type_t type, int16_t threshold, uint8_t radius) {
+    if (is_neighbourhood_threshold(type)) {
+        // Neighbourhood energies must see the unmodified band.
+        int16_t* raw = (int16_t*)malloc(length * sizeof(int16_t));
+        if (!raw) return;
+        memcpy(raw, coeffs, length * sizeof(int16_t));
+        threshold_neighbourhood_span(raw, coeffs, length, 0, length, type, threshold, radius);
+        free(raw);
+        return;
+    }
 
-    switch (config->threshold_type) {
+    switch (type) {
         case THRESHOLD_HARD:
             for (uint16_t i = 0; i < length; i++) {
                 if (abs(coeffs[i]) < threshold) {
@@ -160,94 +670,1949 @@ void apply_thresholding(int16_t* coeffs, uint16_t length, const wavelet_config_t
         case THRESHOLD_ZERO:
             memset(coeffs, 0, length * sizeof(int16_t));
             break;
+        case THRESHOLD_SPIKE:
+            for (uint16_t i = 0; i < length; i++) {
+                if (abs(coeffs[i]) >= threshold) {
+                    coeffs[i] = 0;
+                }
+            }
+            break;
+        default:
+            break;
     }
 }
 
-void wavelet_filter(int16_t* signal, uint16_t length, const wavelet_config_t* config) {
-    if (!signal || !config || length == 0 || length > MAX_SIGNAL_LENGTH) return;
-    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return;
+void apply_thresholding(int16_t* coeffs, uint16_t length, const wavelet_config_t* config) {
+    if (!coeffs || !config || length == 0) return;
 
-    uint16_t current_n = length;
-    uint16_t levels = config->decomposition_levels;
+    threshold_band(coeffs, length, config->threshold_type, config->threshold_value, config->neighbourhood_radius);
+}
 
-    size_t total_coeffs_size = 0;
-    uint16_t temp_n = length;
-    for (uint8_t i = 0; i < levels; i++) {
-        if (temp_n < 2) break;
-        total_coeffs_size += (temp_n >> 1) * 2;
-        temp_n >>= 1;
+// Resolves the threshold applied to `band`, honouring per-level overrides.
+static wavelet_threshold_t band_threshold(const wavelet_config_t* config, uint8_t band) {
+    if (config->per_level_thresholds) {
+        return config->level_threshold[band];
     }
+    wavelet_threshold_t threshold = { config->threshold_type, config->threshold_value };
+    return threshold;
+}
 
-    int16_t* all_coeffs = (int16_t*)malloc(total_coeffs_size * sizeof(int16_t));
-    if (!all_coeffs) {
-        return;
+// Returns non-zero if `band` (0 = cA_n, k = cD_k) is forced to zero by the
+// configuration, in which case it never needs to be computed.
+static int band_is_zeroed(const wavelet_config_t* config, uint8_t band) {
+    switch (config->band_mode[band]) {
+        case WAVELET_BAND_ZERO:
+            return 1;
+        case WAVELET_BAND_DEFAULT:
+            return band != 0 && band_threshold(config, band).threshold_type == THRESHOLD_ZERO;
+        case WAVELET_BAND_THRESHOLD:
+            return band_threshold(config, band).threshold_type == THRESHOLD_ZERO;
+        case WAVELET_BAND_SCALE:
+            return config->band_gain[band] == 0;
+        default:
+            return 0;
     }
+}
 
-    int16_t* approx_coeffs_ptrs[MAX_DECOMPOSITION_LEVELS];
-    int16_t* detail_coeffs_ptrs[MAX_DECOMPOSITION_LEVELS];
+// Applies the configured band mode to the coefficients of one band.
+static void apply_band_mode(int16_t* coeffs, uint16_t length, uint8_t band, const wavelet_config_t* config) {
+    wavelet_threshold_t threshold = band_threshold(config, band);
+
+    switch (config->band_mode[band]) {
+        case WAVELET_BAND_DEFAULT:
+            if (band != 0) threshold_band(coeffs, length, threshold.threshold_type, threshold.threshold_value, config->neighbourhood_radius);
+            break;
+        case WAVELET_BAND_THRESHOLD:
+            threshold_band(coeffs, length, threshold.threshold_type, threshold.threshold_value, config->neighbourhood_radius);
+            break;
+        case WAVELET_BAND_ZERO:
+            memset(coeffs, 0, length * sizeof(int16_t));
+            break;
+        case WAVELET_BAND_SCALE:
+            for (uint16_t i = 0; i < length; i++) {
+                coeffs[i] = round_kernel_acc((int32_t)coeffs[i] * config->band_gain[band]);
+            }
+            break;
+        case WAVELET_BAND_KEEP:
+        default:
+            break;
+    }
+}
 
-    size_t current_offset = 0;
-    temp_n = length;
-    for (uint8_t i = 0; i < levels; i++) {
-        if (temp_n < 2) break;
-        uint16_t half_n = temp_n >> 1;
-        approx_coeffs_ptrs[i] = all_coeffs + current_offset;
-        detail_coeffs_ptrs[i] = all_coeffs + current_offset + half_n;
-        current_offset += half_n * 2;
-        temp_n >>= 1;
+static void apply_band_modes(int16_t* pyramid, uint16_t length, uint8_t levels, const wavelet_config_t* config) {
+    for (uint8_t band = 0; band <= levels; band++) {
+        apply_band_mode(pyramid + wavelet_band_offset(length, levels, band),
+                        wavelet_band_length(length, levels, band), band, config);
     }
+}
 
-    int16_t* current_input_signal = signal;
+uint8_t wavelet_levels_for_length(uint16_t length, const wavelet_config_t* config) {
+    if (!config) return 0;
 
-    for (uint8_t i = 0; i < levels; i++) {
-        if (current_n < 2) {
-            levels = i;
-            break;
-        }
-        uint16_t half_n = current_n >> 1;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, NULL, NULL, &g0_kernel, &g1_kernel, &kernel_len);
 
-        dwt(current_input_signal, approx_coeffs_ptrs[i], detail_coeffs_ptrs[i], current_n, config->wavelet, config->q_format);
-        
-        current_input_signal = approx_coeffs_ptrs[i];
-        current_n = half_n;
+    uint8_t levels = 0;
+    uint16_t n = length;
+    while (levels < config->decomposition_levels && levels < MAX_DECOMPOSITION_LEVELS &&
+           n >= 2 && n >= kernel_len) {
+        n >>= 1;
+        levels++;
+    }
+    return levels;
+}
+
+uint8_t wavelet_kernel_length(wavelet_type_t wavelet) {
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(wavelet, NULL, NULL, &g0_kernel, &g1_kernel, &kernel_len);
+    return kernel_len;
+}
+
+uint16_t wavelet_band_offset(uint16_t length, uint8_t levels, uint8_t band) {
+    if (band == 0) return 0;
+    uint16_t offset = length >> levels;
+    for (uint8_t k = levels; k > band; k--) {
+        offset += length >> k;
     }
+    return offset;
+}
 
-    for (uint8_t i = 0; i < levels; i++) {
-        apply_thresholding(detail_coeffs_ptrs[i], length >> (i + 1), config);
+uint16_t wavelet_band_length(uint16_t length, uint8_t levels, uint8_t band) {
+    return (band == 0) ? (length >> levels) : (length >> band);
+}
+
+// Deepest level whose analysis is needed when only the bands flagged in
+// `active` (index 0 = cA_n, k = cD_k) contribute to the result.
+static uint8_t deepest_active_level(const uint8_t* active, uint8_t levels) {
+    if (active[0]) return levels;
+    uint8_t deepest = levels;
+    while (deepest > 0 && !active[deepest]) deepest--;
+    return deepest;
+}
+
+// Haar engine. Level-k coefficient i of the generic transform pairs
+// approximations 2i - 1 and 2i of level k - 1, so deepest-level index b
+// depends only on samples b * 2^K - 2^K + 1 .. b * 2^K. The fused passes
+// below load one such block, run the whole tree on it in a small local
+// buffer and store every coefficient it produced, instead of streaming the
+// signal once per level. The per-level arithmetic and rounding match
+// dwt_span()/idwt_span() with the Haar kernels, so results are identical.
+
+#define HAAR_Q14 11585 // 1 / sqrt(2) in Q14
+#define HAAR_MAX_BLOCK (1 << MAX_DECOMPOSITION_LEVELS)
+
+// Block b covers entries b * count - count + 1 .. b * count of a level of
+// length n, count entries per block. Only block 0 wraps: its last entry is
+// index 0 and the others are the tail of the level. The same layout holds
+// for the input samples (count = 2^depth) and for every band.
+static void haar_store_block(int16_t* level, uint16_t n, uint16_t b, const int16_t* entries, uint16_t count) {
+    if (b > 0) {
+        memcpy(level + (size_t)(b - 1) * count + 1, entries, count * sizeof(int16_t));
+        return;
     }
+    memcpy(level + n - count + 1, entries, (count - 1) * sizeof(int16_t));
+    level[0] = entries[count - 1];
+}
 
-    int16_t* current_reconstructed_signal = (int16_t*)malloc(current_n * sizeof(int16_t));
-    if (!current_reconstructed_signal) {
-        free(all_coeffs);
+static void haar_load_block(const int16_t* level, uint16_t n, uint16_t b, int16_t* entries, uint16_t count) {
+    if (b > 0) {
+        memcpy(entries, level + (size_t)(b - 1) * count + 1, count * sizeof(int16_t));
         return;
     }
-    memcpy(current_reconstructed_signal, approx_coeffs_ptrs[levels - 1], current_n * sizeof(int16_t));
+    memcpy(entries, level + n - count + 1, (count - 1) * sizeof(int16_t));
+    entries[count - 1] = level[0];
+}
+
+static int haar_fused_fits(uint16_t length, uint8_t depth) {
+    return depth > 0 && depth <= MAX_DECOMPOSITION_LEVELS && (length & ((1u << depth) - 1)) == 0;
+}
 
-    uint16_t current_reconstructed_length = current_n;
+// Runs levels 1 .. depth; details go to active bands, cA_depth to band 0
+// when depth == levels.
+static void haar_decompose_fused(const int16_t* signal, uint16_t length, uint8_t levels, uint8_t depth,
+                                 const uint8_t* active, int16_t* pyramid_out) {
+    uint16_t block = (uint16_t)(1u << depth);
+    uint16_t blocks = length >> depth;
+    int16_t t[HAAR_MAX_BLOCK];
+    int16_t d[HAAR_MAX_BLOCK / 2];
+    int16_t* bands[MAX_DECOMPOSITION_LEVELS + 1];
+    for (uint8_t k = 1; k <= depth; k++) {
+        bands[k] = active[k] ? pyramid_out + wavelet_band_offset(length, levels, k) : NULL;
+    }
 
-    for (int8_t i = levels - 1; i >= 0; i--) {
-        if (i == 0) { // Last level of reconstruction
-            idwt(current_reconstructed_signal, detail_coeffs_ptrs[i], signal, current_reconstructed_length, config->wavelet, config->q_format);
-            free(current_reconstructed_signal);
-            break; // Exit loop after last reconstruction
+    for (uint16_t b = 0; b < blocks; b++) {
+        haar_load_block(signal, length, b, t, block);
+        uint16_t count = block;
+        for (uint8_t k = 1; k <= depth; k++) {
+            count >>= 1;
+            for (uint16_t u = 0; u < count; u++) {
+                int32_t p0 = t[2 * u];
+                int32_t p1 = t[2 * u + 1];
+                if (bands[k]) d[u] = round_kernel_acc((p1 - p0) * HAAR_Q14);
+                t[u] = round_kernel_acc((p0 + p1) * HAAR_Q14);
+            }
+            if (bands[k]) haar_store_block(bands[k], length >> k, b, d, count);
         }
+        if (depth == levels) pyramid_out[b] = t[0];
+    }
+}
 
-        uint16_t next_reconstructed_length = current_reconstructed_length << 1;
-        
-        int16_t* temp_reconstructed_level = (int16_t*)malloc(next_reconstructed_length * sizeof(int16_t));
-        if (!temp_reconstructed_level) {
-            free(all_coeffs);
-            free(current_reconstructed_signal);
-            return;
+// Inverse of haar_decompose_fused() from level `depth` up; inactive bands
+// (and cA when depth < levels) read as zero.
+static void haar_reconstruct_fused(const int16_t* pyramid, uint16_t length, uint8_t levels, uint8_t depth,
+                                   const uint8_t* active, int16_t* signal_out) {
+    uint16_t block = (uint16_t)(1u << depth);
+    uint16_t blocks = length >> depth;
+    int16_t t[HAAR_MAX_BLOCK];
+    int16_t d[HAAR_MAX_BLOCK / 2];
+    const int16_t* bands[MAX_DECOMPOSITION_LEVELS + 1];
+    for (uint8_t k = 1; k <= depth; k++) {
+        bands[k] = active[k] ? pyramid + wavelet_band_offset(length, levels, k) : NULL;
+    }
+
+    for (uint16_t b = 0; b < blocks; b++) {
+        t[0] = (depth == levels && active[0]) ? pyramid[b] : 0;
+        uint16_t count = 1;
+        for (uint8_t k = depth; k >= 1; k--) {
+            if (bands[k]) {
+                haar_load_block(bands[k], length >> k, b, d, count);
+            } else {
+                memset(d, 0, count * sizeof(int16_t));
+            }
+            // Expand back to front so t[u] is read before it is overwritten.
+            for (uint16_t u = count; u-- > 0;) {
+                int32_t a = t[u];
+                t[2 * u] = round_kernel_acc((a - d[u]) * HAAR_Q14);
+                t[2 * u + 1] = round_kernel_acc((a + d[u]) * HAAR_Q14);
+            }
+            count <<= 1;
+        }
+        haar_store_block(signal_out, length, b, t, block);
+    }
+}
+
+// Decomposition that leaves inactive bands unwritten and skips every filter
+// and level that only feeds them.
+static int decompose_bands(const int16_t* signal, uint16_t length, const wavelet_config_t* config,
+                           uint8_t levels, const uint8_t* active, int16_t* pyramid_out) {
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    uint8_t deepest = deepest_active_level(active, levels);
+    if (deepest == 0) return 0;
+
+    if (config->wavelet == WAVELET_HAAR && haar_fused_fits(length, deepest)) {
+        haar_decompose_fused(signal, length, levels, deepest, active, pyramid_out);
+        return 0;
+    }
+
+    // dwt_span() cannot run in place, so intermediate approximations
+    // ping-pong through the two halves of a scratch buffer. Details go
+    // straight to their Mallat slots and cA_n lands at offset 0.
+    int16_t* scratch = (int16_t*)malloc(length * sizeof(int16_t));
+    if (!scratch) return -1;
+
+    const int16_t* current_input = signal;
+    uint16_t current_n = length;
+    for (uint8_t k = 1; k <= deepest; k++) {
+        uint16_t half_n = current_n >> 1;
+        int16_t* detail = active[k] ? pyramid_out + wavelet_band_offset(length, levels, k) : NULL;
+        int16_t* approx = NULL;
+        if (k < deepest) {
+            approx = scratch + ((k & 1) ? 0 : (length >> 1));
+        } else if (k == levels) {
+            approx = pyramid_out;
         }
+        dwt_span(current_input, approx, detail, current_n, h0_kernel, h1_kernel, kernel_len, 0, half_n);
+        current_input = approx;
+        current_n = half_n;
+    }
+
+    free(scratch);
+    return 0;
+}
 
-        idwt(current_reconstructed_signal, detail_coeffs_ptrs[i], temp_reconstructed_level, current_reconstructed_length, config->wavelet, config->q_format);
+// Reconstruction that treats inactive bands as zero without reading them,
+// starting at the deepest level that still carries an active band.
+static int reconstruct_bands(const int16_t* pyramid, uint16_t length, const wavelet_config_t* config,
+                             uint8_t levels, const uint8_t* active, int16_t* signal_out) {
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, NULL, NULL, &g0_kernel, &g1_kernel, &kernel_len);
+
+    uint8_t deepest = deepest_active_level(active, levels);
+    if (deepest == 0) {
+        memset(signal_out, 0, length * sizeof(int16_t));
+        return 0;
+    }
+
+    if (config->wavelet == WAVELET_HAAR && haar_fused_fits(length, deepest)) {
+        haar_reconstruct_fused(pyramid, length, levels, deepest, active, signal_out);
+        return 0;
+    }
+
+    int16_t* scratch = (int16_t*)malloc(length * sizeof(int16_t));
+    if (!scratch) return -1;
+
+    // Ping-pong between the scratch buffer and the output so that the final
+    // level lands in signal_out.
+    int16_t* buffers[2] = { signal_out, scratch };
+    const int16_t* approx = (deepest == levels && active[0]) ? pyramid : NULL;
+    uint16_t current_n = length >> deepest;
+
+    for (uint8_t k = deepest; k >= 1; k--) {
+        const int16_t* detail = active[k] ? pyramid + wavelet_band_offset(length, levels, k) : NULL;
+        int16_t* output = buffers[(k - 1) & 1];
+        idwt_span(approx, detail, output, current_n << 1, g0_kernel, g1_kernel, kernel_len, 0, current_n << 1);
+        approx = output;
+        current_n <<= 1;
+    }
+
+    free(scratch);
+    return 0;
+}
+
+int wavelet_decompose(const int16_t* signal, uint16_t length, const wavelet_config_t* config, int16_t* pyramid_out) {
+    if (!signal || !config || !pyramid_out || length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    if (levels == 0) return -1;
+
+    uint8_t active[MAX_DECOMPOSITION_LEVELS + 1];
+    memset(active, 1, sizeof(active));
+    if (decompose_bands(signal, length, config, levels, active, pyramid_out) != 0) return -1;
+    return levels;
+}
+
+int wavelet_reconstruct(const int16_t* pyramid, uint16_t length, const wavelet_config_t* config, int16_t* signal_out) {
+    if (!pyramid || !config || !signal_out || length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    if (levels == 0) return -1;
+
+    uint8_t active[MAX_DECOMPOSITION_LEVELS + 1];
+    memset(active, 1, sizeof(active));
+    if (reconstruct_bands(pyramid, length, config, levels, active, signal_out) != 0) return -1;
+    return levels;
+}
+
+// Multiresolution analysis by telescoping: V_k is the level-k analysis
+// approximation carried back to full rate through g0 alone, with V_0 the
+// signal itself. Then D_k = V_(k-1) - V_k and A_n = V_n, which sum to the
+// signal exactly whatever the rounding inside each V_k. Every component
+// costs one approximation-only synthesis chain instead of a full
+// reconstruction with all other bands zeroed.
+int wavelet_mra(const int16_t* signal, uint16_t length, const wavelet_config_t* config, int16_t* components_out) {
+    if (!signal || !config || !components_out || length == 0) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    if (levels == 0) return -1;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
 
-        free(current_reconstructed_signal);
+    // The first half holds cA_1 .. cA_n back to back, the second half two
+    // ping-pong buffers for the intermediate synthesis levels.
+    int16_t* scratch = (int16_t*)malloc(2 * (size_t)length * sizeof(int16_t));
+    if (!scratch) return -1;
+    int16_t* upsample[2] = { scratch + length, scratch + length + (length >> 1) };
 
-        current_reconstructed_signal = temp_reconstructed_level;
-        current_reconstructed_length = next_reconstructed_length;
+    const int16_t* approx[MAX_DECOMPOSITION_LEVELS + 1];
+    approx[0] = signal;
+    int16_t* next = scratch;
+    for (uint8_t k = 1; k <= levels; k++) {
+        uint16_t n = length >> (k - 1);
+        dwt_span(approx[k - 1], next, NULL, n, h0_kernel, h1_kernel, kernel_len, 0, n >> 1);
+        approx[k] = next;
+        next += n >> 1;
     }
 
-    free(all_coeffs);
+    // V_k goes to row k, where it stays for A_n and until row k - 1 is final.
+    for (uint8_t k = 1; k <= levels; k++) {
+        int16_t* row = components_out + (size_t)k * length;
+        const int16_t* current = approx[k];
+        uint16_t n = length >> k;
+        for (uint8_t j = k; j >= 1; j--) {
+            int16_t* output = (j == 1) ? row : upsample[j & 1];
+            idwt_span(current, NULL, output, n << 1, g0_kernel, g1_kernel, kernel_len, 0, n << 1);
+            current = output;
+            n <<= 1;
+        }
+        memset(row + n, 0, (length - n) * sizeof(int16_t));
+    }
+
+    memcpy(components_out, signal, length * sizeof(int16_t));
+    for (uint8_t k = 0; k < levels; k++) {
+        int16_t* row = components_out + (size_t)k * length;
+        const int16_t* coarser = row + length;
+        for (uint16_t m = 0; m < length; m++) {
+            row[m] = saturate_int16((int32_t)row[m] - coarser[m]);
+        }
+    }
+
+    free(scratch);
+    return levels;
+}
+
+// haar_store_block() and haar_load_block() for the 32-bit S-transform bands.
+static void haar_s_store_block(int32_t* level, uint16_t n, uint16_t b, const int32_t* entries, uint16_t count) {
+    if (b > 0) {
+        memcpy(level + (size_t)(b - 1) * count + 1, entries, count * sizeof(int32_t));
+        return;
+    }
+    memcpy(level + n - count + 1, entries, (count - 1) * sizeof(int32_t));
+    level[0] = entries[count - 1];
+}
+
+static void haar_s_load_block(const int32_t* level, uint16_t n, uint16_t b, int32_t* entries, uint16_t count) {
+    if (b > 0) {
+        memcpy(entries, level + (size_t)(b - 1) * count + 1, count * sizeof(int32_t));
+        return;
+    }
+    memcpy(entries, level + n - count + 1, (count - 1) * sizeof(int32_t));
+    entries[count - 1] = level[0];
+}
+
+// Levels of the S-transform: the configured depth, reduced until 2^levels
+// divides the length so every block is complete.
+static uint8_t haar_s_levels(uint16_t length, const wavelet_config_t* config) {
+    uint8_t levels = config->decomposition_levels;
+    if (levels > MAX_DECOMPOSITION_LEVELS) levels = MAX_DECOMPOSITION_LEVELS;
+    while (levels > 0 && (length & ((1u << levels) - 1)) != 0) levels--;
+    return levels;
+}
+
+int wavelet_haar_s_decompose(const int16_t* signal, uint16_t length, const wavelet_config_t* config, int32_t* pyramid_out) {
+    if (!signal || !config || !pyramid_out || length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    uint8_t levels = haar_s_levels(length, config);
+    if (levels == 0) return -1;
+
+    uint16_t block = (uint16_t)(1u << levels);
+    uint16_t blocks = length >> levels;
+    int32_t t[HAAR_MAX_BLOCK];
+    int32_t d[HAAR_MAX_BLOCK / 2];
+    int16_t samples[HAAR_MAX_BLOCK];
+    uint16_t offsets[MAX_DECOMPOSITION_LEVELS + 1];
+    for (uint8_t k = 1; k <= levels; k++) offsets[k] = wavelet_band_offset(length, levels, k);
+
+    for (uint16_t b = 0; b < blocks; b++) {
+        haar_load_block(signal, length, b, samples, block);
+        for (uint16_t s = 0; s < block; s++) t[s] = samples[s];
+        uint16_t count = block;
+        for (uint8_t k = 1; k <= levels; k++) {
+            count >>= 1;
+            for (uint16_t u = 0; u < count; u++) {
+                d[u] = t[2 * u + 1] - t[2 * u];
+                t[u] = t[2 * u] + (d[u] >> 1); // floor((p0 + p1) / 2)
+            }
+            haar_s_store_block(pyramid_out + offsets[k], length >> k, b, d, count);
+        }
+        pyramid_out[b] = t[0];
+    }
+    return levels;
+}
+
+int wavelet_haar_s_reconstruct(const int32_t* pyramid, uint16_t length, const wavelet_config_t* config, int16_t* signal_out) {
+    if (!pyramid || !config || !signal_out || length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    uint8_t levels = haar_s_levels(length, config);
+    if (levels == 0) return -1;
+
+    uint16_t block = (uint16_t)(1u << levels);
+    uint16_t blocks = length >> levels;
+    int32_t t[HAAR_MAX_BLOCK];
+    int32_t d[HAAR_MAX_BLOCK / 2];
+    int16_t samples[HAAR_MAX_BLOCK];
+    uint16_t offsets[MAX_DECOMPOSITION_LEVELS + 1];
+    for (uint8_t k = 1; k <= levels; k++) offsets[k] = wavelet_band_offset(length, levels, k);
+
+    for (uint16_t b = 0; b < blocks; b++) {
+        t[0] = pyramid[b];
+        uint16_t count = 1;
+        for (uint8_t k = levels; k >= 1; k--) {
+            haar_s_load_block(pyramid + offsets[k], length >> k, b, d, count);
+            for (uint16_t u = count; u-- > 0;) {
+                int32_t p0 = t[u] - (d[u] >> 1);
+                t[2 * u] = p0;
+                t[2 * u + 1] = p0 + d[u];
+            }
+            count <<= 1;
+        }
+        for (uint16_t s = 0; s < block; s++) samples[s] = saturate_int16(t[s]);
+        haar_store_block(signal_out, length, b, samples, block);
+    }
+    return levels;
+}
+
+// In-place transforms. Each analysis level overwrites its input with
+// interleaved [a0, d0, a1, d1, ...] in increasing order; the inputs that
+// later outputs still need are kept in a small ring, and wrapped reads at
+// the start only touch the untouched end of the buffer. A perfect unshuffle
+// then moves the level into Mallat order. Synthesis mirrors this: shuffle,
+// then overwrite in decreasing order with the ring holding coefficients
+// that were already replaced. Sums and rounding match dwt_span() and
+// idwt_span(), so the results are identical.
+
+#define INPLACE_RING 128 // Power of two > MAX_WAVELET_KERNEL_LENGTH + 1
+#define INPLACE_RING_MASK (INPLACE_RING - 1)
+
+static void reverse_range(int16_t* data, uint16_t first, uint16_t last) {
+    while (first < last) {
+        int16_t tmp = data[first];
+        data[first++] = data[last];
+        data[last--] = tmp;
+    }
+}
+
+// Rotates data[first .. first + count) left by `shift`.
+static void rotate_left(int16_t* data, uint16_t first, uint16_t count, uint16_t shift) {
+    if (shift == 0 || shift >= count) return;
+    reverse_range(data, first, first + shift - 1);
+    reverse_range(data, first + shift, first + count - 1);
+    reverse_range(data, first, first + count - 1);
+}
+
+// [a0, d0, a1, d1, ...] (pairs pairs) -> [a0, a1, ..., d0, d1, ...] by
+// unshuffling each half and rotating the middle: O(n log n), no buffer.
+static void unshuffle_pairs(int16_t* data, uint16_t pairs) {
+    if (pairs < 2) return;
+    uint16_t left = pairs >> 1;
+    uint16_t right = pairs - left;
+    unshuffle_pairs(data, left);
+    unshuffle_pairs(data + 2 * left, right);
+    // [A1 D1 | A2 D2] -> [A1 A2 D1 D2]
+    rotate_left(data, left, left + right, left);
+}
+
+// Inverse of unshuffle_pairs().
+static void shuffle_pairs(int16_t* data, uint16_t pairs) {
+    if (pairs < 2) return;
+    uint16_t left = pairs >> 1;
+    uint16_t right = pairs - left;
+    // [A1 A2 D1 D2] -> [A1 D1 | A2 D2]
+    rotate_left(data, left, left + right, right);
+    shuffle_pairs(data, left);
+    shuffle_pairs(data + 2 * left, right);
+}
+
+static void inplace_analysis_level(int16_t* data, uint16_t n, const int16_t* h0_kernel, const int16_t* h1_kernel,
+                                   uint8_t kernel_len, int16_t* ring) {
+    for (uint16_t i = 0; i < (n >> 1); i++) {
+        ring[(2 * i) & INPLACE_RING_MASK] = data[2 * i];
+        ring[(2 * i + 1) & INPLACE_RING_MASK] = data[2 * i + 1];
+        int32_t approx_val = 0;
+        int32_t detail_val = 0;
+        for (uint8_t j = 0; j < kernel_len; j++) {
+            int32_t p = 2 * i - j;
+            int32_t x = (p >= 0) ? ring[p & INPLACE_RING_MASK] : data[p + n];
+            approx_val += x * h0_kernel[j];
+            detail_val += x * h1_kernel[j];
+        }
+        data[2 * i] = round_kernel_acc(approx_val);
+        data[2 * i + 1] = round_kernel_acc(detail_val);
+    }
+}
+
+static void inplace_synthesis_level(int16_t* data, uint16_t n, const int16_t* g0_kernel, const int16_t* g1_kernel,
+                                    uint8_t kernel_len, int16_t* ring) {
+    for (uint16_t m = n; m-- > 0;) {
+        ring[m & INPLACE_RING_MASK] = data[m];
+        int32_t acc = 0;
+        for (uint8_t j = (m + kernel_len - 1) & 1; j < kernel_len; j += 2) {
+            uint32_t q = (uint32_t)(m + kernel_len - 1 - j) & ~1u; // Unwrapped position of a[i]
+            int32_t a, d;
+            if (q >= n) {
+                a = data[q - n];
+                d = data[q - n + 1];
+            } else {
+                a = (q >= m) ? ring[q & INPLACE_RING_MASK] : data[q];
+                d = ring[(q + 1) & INPLACE_RING_MASK];
+            }
+            acc += a * g0_kernel[j] + d * g1_kernel[j];
+        }
+        data[m] = round_kernel_acc(acc);
+    }
+}
+
+static int inplace_levels(uint16_t length, const wavelet_config_t* config) {
+    if (!config || length == 0) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    return (levels == 0) ? -1 : levels;
+}
+
+int wavelet_decompose_inplace(int16_t* signal, uint16_t length, const wavelet_config_t* config) {
+    if (!signal) return -1;
+    int levels = inplace_levels(length, config);
+    if (levels < 0) return -1;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    int16_t ring[INPLACE_RING];
+    uint16_t n = length;
+    for (int k = 1; k <= levels; k++) {
+        inplace_analysis_level(signal, n, h0_kernel, h1_kernel, kernel_len, ring);
+        unshuffle_pairs(signal, n >> 1);
+        n >>= 1;
+    }
+    return levels;
+}
+
+int wavelet_reconstruct_inplace(int16_t* pyramid, uint16_t length, const wavelet_config_t* config) {
+    if (!pyramid) return -1;
+    int levels = inplace_levels(length, config);
+    if (levels < 0) return -1;
+
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, NULL, NULL, &g0_kernel, &g1_kernel, &kernel_len);
+
+    int16_t ring[INPLACE_RING];
+    for (int k = levels; k >= 1; k--) {
+        uint16_t n = length >> (k - 1);
+        shuffle_pairs(pyramid, n >> 1);
+        inplace_synthesis_level(pyramid, n, g0_kernel, g1_kernel, kernel_len, ring);
+    }
+    return levels;
+}
+
+void wavelet_filter_inplace(int16_t* signal, uint16_t length, const wavelet_config_t* config) {
+    int levels = wavelet_decompose_inplace(signal, length, config);
+    if (levels < 0) return;
+    apply_band_modes(signal, length, (uint8_t)levels, config);
+    wavelet_reconstruct_inplace(signal, length, config);
+}
+
+void wavelet_long_filter_window(int16_t* window, uint16_t length, const wavelet_config_t* config) {
+    uint8_t kernel_len = wavelet_kernel_length(config->wavelet);
+    int levels = inplace_levels(length, config);
+    int16_t* pyramid = (levels > 0 && uses_fft(kernel_len, length)) ? (int16_t*)malloc(length * sizeof(int16_t)) : NULL;
+    if (!pyramid) {
+        wavelet_filter_inplace(window, length, config);
+        return;
+    }
+
+    uint8_t active[MAX_DECOMPOSITION_LEVELS + 1];
+    for (uint8_t band = 0; band <= levels; band++) {
+        active[band] = !band_is_zeroed(config, band);
+    }
+    int status = decompose_bands(window, length, config, (uint8_t)levels, active, pyramid);
+    if (status == 0) {
+        for (uint8_t band = 0; band <= levels; band++) {
+            if (active[band]) {
+                apply_band_mode(pyramid + wavelet_band_offset(length, (uint8_t)levels, band),
+                                wavelet_band_length(length, (uint8_t)levels, band), band, config);
+            }
+        }
+        status = reconstruct_bands(pyramid, length, config, (uint8_t)levels, active, window);
+    }
+    free(pyramid);
+    // Both steps fail before writing to `window`, so it still holds the input.
+    if (status != 0) wavelet_filter_inplace(window, length, config);
+}
+
+// Depth-first cascade for long signals. Analysis pushes one block of the
+// signal through every level before reading the next, so each level only
+// touches a block-sized buffer plus an (L - 1)-sample history carried from
+// the previous block. The wrapped history of the first block is the tail of
+// every level, computed up front from a cone of (about 2^levels * L)
+// samples at the end of the signal. Synthesis pulls: producing a chunk of
+// level k - 1 needs level-k coefficients L / 2 - 1 past the chunk, so each
+// level runs ahead of the one below through a small ring, and the first
+// L / 2 coefficients of every level are kept for the wrap at the end.
+// Without detail bands the same cascades are a 2^levels decimator and
+// interpolator that only ever touch the h0 / g0 branch.
+
+#define WAVELET_CASCADE_BLOCK 2048 // Signal samples per analysis block
+#define WAVELET_CASCADE_CHUNK 1024 // Outputs per synthesis step at every level
+#define WAVELET_CASCADE_RING 4096  // Power of two >= 2 * CHUNK + MAX_WAVELET_KERNEL_LENGTH
+
+// wavelet_levels_for_length() for 32-bit lengths, reduced until 2^levels
+// divides the length so every block holds whole coefficients.
+static uint8_t cascade_levels(uint32_t length, const wavelet_config_t* config) {
+    if (!config || length == 0) return 0;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return 0;
+
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, NULL, NULL, &g0_kernel, &g1_kernel, &kernel_len);
+
+    uint8_t levels = 0;
+    uint32_t n = length;
+    while (levels < config->decomposition_levels && n >= 2 && n >= kernel_len && !(n & 1)) {
+        n >>= 1;
+        levels++;
+    }
+    return levels;
+}
+
+static uint32_t cascade_band_offset(uint32_t length, uint8_t levels, uint8_t band) {
+    if (band == 0) return 0;
+    uint32_t offset = length >> levels;
+    for (uint8_t k = levels; k > band; k--) offset += length >> k;
+    return offset;
+}
+
+// Writes cA_levels to approx_out and, unless pyramid_out is NULL, the
+// detail bands at their Mallat offsets in pyramid_out.
+static int cascade_analysis(const int16_t* signal, uint32_t length, uint8_t levels, wavelet_type_t wavelet,
+                            int16_t* approx_out, int16_t* pyramid_out) {
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+    uint16_t history = kernel_len - 1;
+
+    // need[k]: trailing samples of level k (0 = the signal) required, the
+    // last `history` of them as level k + 1's first history and the rest
+    // to compute level k + 1's own tail.
+    uint32_t need[MAX_DECOMPOSITION_LEVELS];
+    uint32_t tail_total = 0;
+    need[levels - 1] = history;
+    for (uint8_t k = levels - 1; k > 0; k--) need[k - 1] = 2 * need[k] + history;
+    for (uint8_t k = 0; k < levels; k++) tail_total += need[k];
+
+    size_t buffer_total = tail_total;
+    for (uint8_t k = 1; k <= levels; k++) buffer_total += history + (WAVELET_CASCADE_BLOCK >> (k - 1));
+    int16_t* buffers = (int16_t*)malloc(buffer_total * sizeof(int16_t));
+    if (!buffers) return -1;
+
+    int16_t* tails[MAX_DECOMPOSITION_LEVELS];
+    int16_t* inputs[MAX_DECOMPOSITION_LEVELS + 1];
+    int16_t* next = buffers;
+    for (uint8_t k = 0; k < levels; k++) {
+        tails[k] = next;
+        next += need[k];
+    }
+    for (uint8_t k = 1; k <= levels; k++) {
+        inputs[k] = next;
+        next += history + (WAVELET_CASCADE_BLOCK >> (k - 1));
+    }
+
+    // Tail cone; level 0 wraps if the cone is longer than the signal.
+    for (uint32_t t = 0; t < need[0]; t++) {
+        tails[0][t] = signal[(uint32_t)(((uint64_t)length * (need[0] / length + 1) - need[0] + t) % length)];
+    }
+    for (uint8_t k = 1; k < levels; k++) {
+        dwt_interior(tails[k - 1] + history, tails[k], NULL, h0_kernel, h1_kernel, kernel_len, 0, (uint16_t)need[k]);
+    }
+    for (uint8_t k = 1; k <= levels; k++) {
+        memcpy(inputs[k], tails[k - 1] + need[k - 1] - history, history * sizeof(int16_t));
+    }
+
+    uint32_t offsets[MAX_DECOMPOSITION_LEVELS + 1];
+    for (uint8_t k = 1; k <= levels; k++) offsets[k] = cascade_band_offset(length, levels, k);
+
+    for (uint32_t start = 0; start < length; start += WAVELET_CASCADE_BLOCK) {
+        uint32_t block = length - start;
+        if (block > WAVELET_CASCADE_BLOCK) block = WAVELET_CASCADE_BLOCK;
+        memcpy(inputs[1] + history, signal + start, block * sizeof(int16_t));
+
+        for (uint8_t k = 1; k <= levels; k++) {
+            uint16_t in_count = (uint16_t)(block >> (k - 1));
+            uint32_t first = start >> k;
+            int16_t* approx = (k < levels) ? inputs[k + 1] + history : approx_out + first;
+            int16_t* detail = pyramid_out ? pyramid_out + offsets[k] + first : NULL;
+            dwt_interior(inputs[k] + history, approx, detail, h0_kernel, h1_kernel, kernel_len, 0, in_count >> 1);
+            memmove(inputs[k], inputs[k] + in_count, history * sizeof(int16_t));
+        }
+    }
+
+    free(buffers);
+    return levels;
+}
+
+int wavelet_decompose_blocked(const int16_t* signal, uint32_t length, const wavelet_config_t* config, int16_t* pyramid_out) {
+    if (!signal || !pyramid_out) return -1;
+    uint8_t levels = cascade_levels(length, config);
+    if (levels == 0) return -1;
+    return cascade_analysis(signal, length, levels, config->wavelet, pyramid_out, pyramid_out);
+}
+
+int wavelet_decimate(const int16_t* signal, uint32_t length, const wavelet_config_t* config, int16_t* approx_out) {
+    if (!signal || !approx_out) return -1;
+    uint8_t levels = cascade_levels(length, config);
+    if (levels == 0) return -1;
+    return cascade_analysis(signal, length, levels, config->wavelet, approx_out, NULL);
+}
+
+typedef struct {
+    const int16_t* approx_in; // cA_levels
+    const int16_t* pyramid;   // Detail bands at their Mallat offsets, or NULL for zeros
+    int16_t* signal_out;
+    uint32_t length;
+    uint8_t levels;
+    const int16_t* g0_kernel;
+    const int16_t* g1_kernel;
+    uint8_t kernel_len;
+    uint32_t offsets[MAX_DECOMPOSITION_LEVELS + 1];
+    uint32_t produced[MAX_DECOMPOSITION_LEVELS + 1];              // Outputs of stage k (level k - 1 values)
+    int16_t* rings[MAX_DECOMPOSITION_LEVELS];                     // Level k values for 1 <= k < levels
+    int16_t heads[MAX_DECOMPOSITION_LEVELS][MAX_WAVELET_KERNEL_LENGTH / 2];
+    int16_t approx[WAVELET_CASCADE_CHUNK / 2 + MAX_WAVELET_KERNEL_LENGTH / 2];
+    int16_t detail[WAVELET_CASCADE_CHUNK / 2 + MAX_WAVELET_KERNEL_LENGTH / 2];
+    int16_t output[WAVELET_CASCADE_CHUNK];
+} cascade_synthesis_t;
+
+// Produces the next chunk of level k - 1 from level k.
+static void cascade_synthesis_step(cascade_synthesis_t* ctx, uint8_t k) {
+    uint32_t n_out = ctx->length >> (k - 1);
+    uint32_t n_in = n_out >> 1;
+    uint32_t first = ctx->produced[k];
+    uint32_t count = n_out - first;
+    if (count > WAVELET_CASCADE_CHUNK) count = WAVELET_CASCADE_CHUNK;
+    uint16_t half_len = ctx->kernel_len >> 1;
+
+    // Coefficients first / 2 .. first / 2 + count / 2 + L / 2 - 1; the ones
+    // past the end wrap to the start of the level.
+    uint32_t lo = first >> 1;
+    uint16_t span = (uint16_t)(count / 2 + half_len);
+    if (k < ctx->levels) {
+        uint32_t needed = lo + span;
+        if (needed > n_in) needed = n_in;
+        while (ctx->produced[k + 1] < needed) cascade_synthesis_step(ctx, k + 1);
+    }
+    for (uint16_t t = 0; t < span; t++) {
+        uint32_t i = lo + t;
+        uint32_t wrapped = (i < n_in) ? i : i % n_in;
+        if (k == ctx->levels) {
+            ctx->approx[t] = ctx->approx_in[wrapped];
+        } else {
+            ctx->approx[t] = (i < n_in) ? ctx->rings[k][i & (WAVELET_CASCADE_RING - 1)] : ctx->heads[k][wrapped];
+        }
+        if (ctx->pyramid) ctx->detail[t] = ctx->pyramid[ctx->offsets[k] + wrapped];
+    }
+
+    int16_t* output = (k == 1) ? ctx->signal_out + first : ctx->output;
+    idwt_interior(ctx->approx, ctx->pyramid ? ctx->detail : NULL, output, ctx->g0_kernel, ctx->g1_kernel, ctx->kernel_len, 0, (uint16_t)count);
+    if (k > 1) {
+        for (uint32_t m = 0; m < count; m++) {
+            uint32_t index = first + m;
+            ctx->rings[k - 1][index & (WAVELET_CASCADE_RING - 1)] = output[m];
+            if (index < half_len) ctx->heads[k - 1][index] = output[m];
+        }
+    }
+    ctx->produced[k] += count;
+}
+
+// Synthesizes `length` samples from cA_levels and the detail bands of
+// pyramid (all zero if pyramid is NULL).
+static int cascade_synthesis(const int16_t* approx, const int16_t* pyramid, uint32_t length, uint8_t levels,
+                             wavelet_type_t wavelet, int16_t* signal_out) {
+    cascade_synthesis_t* ctx = (cascade_synthesis_t*)calloc(1, sizeof(cascade_synthesis_t));
+    int16_t* rings = (levels > 1) ? (int16_t*)malloc((size_t)(levels - 1) * WAVELET_CASCADE_RING * sizeof(int16_t)) : NULL;
+    if (!ctx || (levels > 1 && !rings)) {
+        free(ctx);
+        free(rings);
+        return -1;
+    }
+
+    ctx->approx_in = approx;
+    ctx->pyramid = pyramid;
+    ctx->signal_out = signal_out;
+    ctx->length = length;
+    ctx->levels = levels;
+    get_wavelet_coeffs(wavelet, NULL, NULL, &ctx->g0_kernel, &ctx->g1_kernel, &ctx->kernel_len);
+    for (uint8_t k = 1; k <= levels; k++) ctx->offsets[k] = cascade_band_offset(length, levels, k);
+    for (uint8_t k = 1; k < levels; k++) ctx->rings[k] = rings + (size_t)(k - 1) * WAVELET_CASCADE_RING;
+
+    while (ctx->produced[1] < length) cascade_synthesis_step(ctx, 1);
+
+    free(rings);
+    free(ctx);
+    return levels;
+}
+
+int wavelet_reconstruct_blocked(const int16_t* pyramid, uint32_t length, const wavelet_config_t* config, int16_t* signal_out) {
+    if (!pyramid || !signal_out) return -1;
+    uint8_t levels = cascade_levels(length, config);
+    if (levels == 0) return -1;
+    return cascade_synthesis(pyramid, pyramid, length, levels, config->wavelet, signal_out);
+}
+
+int wavelet_upsample(const int16_t* approx, uint32_t length, const wavelet_config_t* config, int16_t* signal_out) {
+    if (!approx || !signal_out) return -1;
+    uint8_t levels = cascade_levels(length, config);
+    if (levels == 0) return -1;
+    return cascade_synthesis(approx, NULL, length, levels, config->wavelet, signal_out);
+}
+
+static void store_band_features(const band_accumulator_t* acc, uint16_t band_len, float* band) {
+    band[WAVELET_FEATURE_ENERGY] = (float)acc->energy;
+    band[WAVELET_FEATURE_MEAN_ABS] = (float)acc->abs_sum / (float)band_len;
+    if (acc->energy > 0) {
+        // H = -sum p ln p with p = c^2 / E, expanded to ln E - sum(c^2 ln c^2) / E.
+        double energy = (double)acc->energy;
+        band[WAVELET_FEATURE_ENTROPY] = (float)(log(energy) - acc->weighted_log_energy / energy);
+    }
+    band[WAVELET_FEATURE_ZERO_CROSSINGS] = (float)acc->zero_crossings;
+    band[WAVELET_FEATURE_MAX_ABS] = (float)acc->max_abs;
+}
+
+int wavelet_extract_features(const int16_t* signal, uint16_t length, const wavelet_config_t* config, float* features_out) {
+    if (!signal || !config || !features_out || length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    if (levels == 0) return -1;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    memset(features_out, 0, WAVELET_FEATURE_VECTOR_LENGTH * sizeof(float));
+
+    // Two half-length ping-pong buffers carry the approximations down the
+    // cascade. The details are never stored: the analysis kernel folds each
+    // one into the band's statistics as it is computed.
+    int16_t* scratch = (int16_t*)malloc(length * sizeof(int16_t));
+    if (!scratch) return -1;
+
+    const int16_t* current_input = signal;
+    uint16_t current_n = length;
+    for (uint8_t k = 1; k <= levels; k++) {
+        int16_t* approx = scratch + ((k & 1) ? 0 : (length >> 1));
+        uint16_t band_len = current_n >> 1;
+        band_accumulator_t acc;
+        memset(&acc, 0, sizeof(acc));
+        dwt_span_features(current_input, approx, NULL, current_n, h0_kernel, h1_kernel, kernel_len, 0, band_len, &acc);
+        store_band_features(&acc, band_len, features_out + (k - 1) * WAVELET_FEATURES_PER_BAND);
+
+        current_input = approx;
+        current_n = band_len;
+    }
+
+    free(scratch);
+    return levels;
+}
+
+// Subtracts the synthesis contribution of a single cD_k coefficient from
+// `signal`. The contribution is spread one level at a time (g1 once, then g0)
+// over its growing footprint only. `work_a`/`work_b` must be zero on entry
+// and are left zeroed.
+static void subtract_detail_contribution(int16_t* signal, uint16_t length, uint8_t k, uint16_t index, int16_t value,
+                                         const int16_t* g0_kernel, const int16_t* g1_kernel, uint8_t kernel_len,
+                                         int32_t* work_a, int32_t* work_b) {
+    int32_t* current = work_a;
+    int32_t* next = work_b;
+    uint16_t n = length >> k;
+    sample_span_t span = { index, (int32_t)index + 1 };
+    current[index] = value;
+
+    for (uint8_t level = k; level >= 1; level--) {
+        const int16_t* kernel = (level == k) ? g1_kernel : g0_kernel;
+        uint16_t output_len = n << 1;
+        sample_span_t out_span = synthesis_cone(span, kernel_len, output_len);
+
+        for (int32_t c = span.start; c < span.end; c++) {
+            uint16_t i = wrap_index(c, n);
+            int32_t v = current[i];
+            current[i] = 0;
+            if (v == 0) continue;
+            for (uint8_t j = 0; j < kernel_len; j++) {
+                next[wrap_index(2 * (int32_t)i + j - (kernel_len - 1), output_len)] += v * kernel[j];
+            }
+        }
+        for (int32_t c = out_span.start; c < out_span.end; c++) {
+            uint16_t m = wrap_index(c, output_len);
+            next[m] = (next[m] + (1 << (KERNEL_Q - 1))) >> KERNEL_Q;
+        }
+
+        int32_t* swap = current;
+        current = next;
+        next = swap;
+        span = out_span;
+        n = output_len;
+    }
+
+    for (int32_t c = span.start; c < span.end; c++) {
+        uint16_t m = wrap_index(c, length);
+        signal[m] = saturate_int16((int32_t)signal[m] - current[m]);
+        current[m] = 0;
+    }
+}
+
+// Returns non-zero if every band uses the default mode with the global
+// threshold, i.e. only the detail bands are thresholded and cA_n is kept.
+static int uses_plain_thresholding(const wavelet_config_t* config, uint8_t levels) {
+    if (config->per_level_thresholds) return 0;
+    for (uint8_t band = 0; band <= levels; band++) {
+        if (config->band_mode[band] != WAVELET_BAND_DEFAULT) return 0;
+    }
+    return 1;
+}
+
+// THRESHOLD_SPIKE fast path: when only a few detail coefficients reach the
+// threshold, subtract their contributions from the signal instead of
+// reconstructing it. Returns -1 without touching `signal` if the outliers are
+// not sparse enough for this to pay off, or if length is not a multiple of
+// 2^levels: the odd samples dropped along the cascade keep the synthesis from
+// inverting the analysis, so the unpatched signal is not what a full
+// reconstruction would return.
+static int patch_sparse_spikes(int16_t* signal, uint16_t length, uint8_t levels, const int16_t* pyramid, const wavelet_config_t* config) {
+    if (length & ((1u << levels) - 1)) return -1;
+
+    // The bands end at cD_1; past it the pyramid holds no coefficients.
+    uint16_t outliers = 0;
+    uint16_t detail_start = wavelet_band_offset(length, levels, levels);
+    uint16_t detail_end = wavelet_band_offset(length, levels, 1) + (length >> 1);
+    for (uint16_t i = detail_start; i < detail_end; i++) {
+        if (abs(pyramid[i]) >= config->threshold_value) outliers++;
+    }
+    if (outliers > length / WAVELET_SPIKE_PATCH_DIVISOR) return -1;
+    if (outliers == 0) return 0;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    int32_t* work = (int32_t*)calloc(2 * length, sizeof(int32_t));
+    if (!work) return -1;
+
+    for (uint8_t k = 1; k <= levels; k++) {
+        const int16_t* band = pyramid + wavelet_band_offset(length, levels, k);
+        for (uint16_t i = 0; i < (length >> k); i++) {
+            if (abs(band[i]) < config->threshold_value) continue;
+            subtract_detail_contribution(signal, length, k, i, band[i], g0_kernel, g1_kernel, kernel_len,
+                                         work, work + length);
+        }
+    }
+
+    free(work);
+    return 0;
+}
+
+void wavelet_filter(int16_t* signal, uint16_t length, const wavelet_config_t* config) {
+    if (!signal || !config || length == 0 || length > MAX_SIGNAL_LENGTH) return;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return;
+
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    if (levels == 0) return;
+
+    int16_t* pyramid = (int16_t*)malloc(length * sizeof(int16_t));
+    if (!pyramid) {
+        return;
+    }
+
+    // Bands that the configuration zeroes are neither analysed nor synthesized.
+    uint8_t active[MAX_DECOMPOSITION_LEVELS + 1];
+    for (uint8_t band = 0; band <= levels; band++) {
+        active[band] = !band_is_zeroed(config, band);
+    }
+
+    if (decompose_bands(signal, length, config, levels, active, pyramid) == 0) {
+        if (config->threshold_type == THRESHOLD_SPIKE && uses_plain_thresholding(config, levels) &&
+            patch_sparse_spikes(signal, length, levels, pyramid, config) == 0) {
+            free(pyramid);
+            return;
+        }
+        for (uint8_t band = 0; band <= levels; band++) {
+            if (active[band]) {
+                apply_band_mode(pyramid + wavelet_band_offset(length, levels, band),
+                                wavelet_band_length(length, levels, band), band, config);
+            }
+        }
+        reconstruct_bands(pyramid, length, config, levels, active, signal);
+    }
+
+    free(pyramid);
+}
+
+// Lane-parallel transform for wavelet_filter_batch(). Buffers are
+// transposed so sample t of lane l sits at [t * WAVELET_BATCH_LANES + l];
+// every tap then feeds a whole row of lanes with one load, and the lane
+// loops have a constant trip count the compiler can vectorize. Indexing
+// and rounding mirror dwt_span() / idwt_span() exactly. When `features` is
+// non-NULL the details of its first `feature_lanes` lanes are folded into
+// features[l] as they are produced, and `detail` may be NULL.
+static void batch_analysis_level(const int16_t* input, int16_t* approx, int16_t* detail, uint16_t n,
+                                 const int16_t* h0_kernel, const int16_t* h1_kernel, uint8_t kernel_len,
+                                 band_accumulator_t* features, uint8_t feature_lanes) {
+    for (uint16_t i = 0; i < (n >> 1); i++) {
+        int32_t approx_acc[WAVELET_BATCH_LANES] = { 0 };
+        int32_t detail_acc[WAVELET_BATCH_LANES] = { 0 };
+        for (uint8_t j = 0; j < kernel_len; j++) {
+            const int16_t* row = input + (size_t)wrap_index(2 * i - j, n) * WAVELET_BATCH_LANES;
+            for (uint8_t l = 0; l < WAVELET_BATCH_LANES; l++) {
+                approx_acc[l] += (int32_t)row[l] * h0_kernel[j];
+                detail_acc[l] += (int32_t)row[l] * h1_kernel[j];
+            }
+        }
+        for (uint8_t l = 0; l < WAVELET_BATCH_LANES; l++) {
+            approx[(size_t)i * WAVELET_BATCH_LANES + l] = round_kernel_acc(approx_acc[l]);
+        }
+        if (detail) {
+            for (uint8_t l = 0; l < WAVELET_BATCH_LANES; l++) {
+                detail[(size_t)i * WAVELET_BATCH_LANES + l] = round_kernel_acc(detail_acc[l]);
+            }
+        }
+        if (features) {
+            for (uint8_t l = 0; l < feature_lanes; l++) band_accumulate(&features[l], round_kernel_acc(detail_acc[l]));
+        }
+    }
+}
+
+static void batch_synthesis_level(const int16_t* approx, const int16_t* detail, int16_t* output, uint16_t output_len,
+                                  const int16_t* g0_kernel, const int16_t* g1_kernel, uint8_t kernel_len) {
+    for (uint16_t m = 0; m < output_len; m++) {
+        int32_t acc[WAVELET_BATCH_LANES] = { 0 };
+        for (uint8_t j = (m + kernel_len - 1) & 1; j < kernel_len; j += 2) {
+            size_t i = (size_t)(((m + kernel_len - 1 - j) % output_len) >> 1) * WAVELET_BATCH_LANES;
+            for (uint8_t l = 0; l < WAVELET_BATCH_LANES; l++) {
+                acc[l] += (int32_t)approx[i + l] * g0_kernel[j] + (int32_t)detail[i + l] * g1_kernel[j];
+            }
+        }
+        for (uint8_t l = 0; l < WAVELET_BATCH_LANES; l++) {
+            output[(size_t)m * WAVELET_BATCH_LANES + l] = round_kernel_acc(acc[l]);
+        }
+    }
+}
+
+int wavelet_filter_batch(int16_t* const* frames, uint16_t count, uint16_t length, const wavelet_config_t* config) {
+    if (!frames || !config || length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+    for (uint16_t f = 0; f < count; f++) {
+        if (!frames[f]) return -1;
+    }
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    if (levels == 0) return -1;
+
+    // Spike patching decides per frame whether to take its shortcut, which
+    // would not give the same result as the full transform in a lane.
+    if (config->threshold_type == THRESHOLD_SPIKE && uses_plain_thresholding(config, levels)) {
+        for (uint16_t f = 0; f < count; f++) wavelet_filter(frames[f], length, config);
+        return 0;
+    }
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    // Transposed signal, pyramid and one band, plus two half-length
+    // ping-pong buffers for the intermediate approximations.
+    size_t rows = (size_t)length * WAVELET_BATCH_LANES;
+    int16_t* work = (int16_t*)malloc((3 * rows + length) * sizeof(int16_t));
+    if (!work) return -1;
+    int16_t* lanes = work;
+    int16_t* pyramid = work + rows;
+    int16_t* halves[2] = { work + 2 * rows, work + 2 * rows + rows / 2 };
+    int16_t* band = work + 3 * rows;
+
+    for (uint16_t first = 0; first < count; first += WAVELET_BATCH_LANES) {
+        uint16_t used = count - first;
+        if (used > WAVELET_BATCH_LANES) used = WAVELET_BATCH_LANES;
+
+        // Unused lanes run on zeros and are discarded.
+        memset(lanes, 0, rows * sizeof(int16_t));
+        for (uint8_t l = 0; l < used; l++) {
+            const int16_t* frame = frames[first + l];
+            for (uint16_t t = 0; t < length; t++) lanes[(size_t)t * WAVELET_BATCH_LANES + l] = frame[t];
+        }
+
+        const int16_t* input = lanes;
+        uint16_t n = length;
+        for (uint8_t k = 1; k <= levels; k++) {
+            int16_t* approx = (k == levels) ? pyramid : halves[k & 1];
+            int16_t* detail = pyramid + (size_t)wavelet_band_offset(length, levels, k) * WAVELET_BATCH_LANES;
+            batch_analysis_level(input, approx, detail, n, h0_kernel, h1_kernel, kernel_len, NULL, 0);
+            input = approx;
+            n >>= 1;
+        }
+
+        // Band modes operate on contiguous coefficients, so each band of
+        // each lane is gathered, processed and scattered back.
+        for (uint8_t b = 0; b <= levels; b++) {
+            int16_t* coeffs = pyramid + (size_t)wavelet_band_offset(length, levels, b) * WAVELET_BATCH_LANES;
+            uint16_t band_len = wavelet_band_length(length, levels, b);
+            for (uint8_t l = 0; l < used; l++) {
+                for (uint16_t i = 0; i < band_len; i++) band[i] = coeffs[(size_t)i * WAVELET_BATCH_LANES + l];
+                apply_band_mode(band, band_len, b, config);
+                for (uint16_t i = 0; i < band_len; i++) coeffs[(size_t)i * WAVELET_BATCH_LANES + l] = band[i];
+            }
+        }
+
+        const int16_t* approx = pyramid;
+        n = length >> levels;
+        for (uint8_t k = levels; k >= 1; k--) {
+            const int16_t* detail = pyramid + (size_t)wavelet_band_offset(length, levels, k) * WAVELET_BATCH_LANES;
+            int16_t* output = (k == 1) ? lanes : halves[k & 1];
+            batch_synthesis_level(approx, detail, output, n << 1, g0_kernel, g1_kernel, kernel_len);
+            approx = output;
+            n <<= 1;
+        }
+
+        for (uint8_t l = 0; l < used; l++) {
+            int16_t* frame = frames[first + l];
+            for (uint16_t t = 0; t < length; t++) frame[t] = lanes[(size_t)t * WAVELET_BATCH_LANES + l];
+        }
+    }
+
+    free(work);
+    return 0;
+}
+
+int wavelet_extract_features_batch(const int16_t* signals, uint16_t channels, uint16_t length, const wavelet_config_t* config, float* features_out) {
+    if (!signals || !config || !features_out || channels == 0) return -1;
+    if (length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    if (levels == 0) return -1;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    // Transposed channels and two half-length approximation buffers, all
+    // WAVELET_BATCH_LANES wide. The details go straight into the per-lane
+    // statistics and are never stored.
+    size_t rows = (size_t)length * WAVELET_BATCH_LANES;
+    int16_t* work = (int16_t*)malloc((rows + rows) * sizeof(int16_t));
+    if (!work) return -1;
+    int16_t* lanes = work;
+    int16_t* halves[2] = { work + rows, work + rows + rows / 2 };
+
+    for (uint16_t first = 0; first < channels; first += WAVELET_BATCH_LANES) {
+        uint16_t used = channels - first;
+        if (used > WAVELET_BATCH_LANES) used = WAVELET_BATCH_LANES;
+
+        // Unused lanes run on zeros and are discarded.
+        memset(lanes, 0, rows * sizeof(int16_t));
+        for (uint8_t l = 0; l < used; l++) {
+            const int16_t* channel = signals + (size_t)(first + l) * length;
+            for (uint16_t t = 0; t < length; t++) lanes[(size_t)t * WAVELET_BATCH_LANES + l] = channel[t];
+            memset(features_out + (size_t)(first + l) * WAVELET_FEATURE_VECTOR_LENGTH, 0,
+                   WAVELET_FEATURE_VECTOR_LENGTH * sizeof(float));
+        }
+
+        const int16_t* input = lanes;
+        uint16_t n = length;
+        for (uint8_t k = 1; k <= levels; k++) {
+            int16_t* approx = halves[k & 1];
+            uint16_t band_len = n >> 1;
+            band_accumulator_t acc[WAVELET_BATCH_LANES];
+            memset(acc, 0, sizeof(acc));
+            batch_analysis_level(input, approx, NULL, n, h0_kernel, h1_kernel, kernel_len, acc, (uint8_t)used);
+            for (uint8_t l = 0; l < used; l++) {
+                store_band_features(&acc[l], band_len, features_out + (size_t)(first + l) * WAVELET_FEATURE_VECTOR_LENGTH +
+                                                       (k - 1) * WAVELET_FEATURES_PER_BAND);
+            }
+            input = approx;
+            n = band_len;
+        }
+    }
+
+    free(work);
+    return levels;
+}
+
+int wavelet_filter_sweep(const int16_t* signal, uint16_t length, const wavelet_config_t* config,
+                         const wavelet_threshold_t* thresholds, uint16_t count, int16_t* outputs,
+                         const int16_t* reference, wavelet_sweep_metrics_t* metrics_out) {
+    if (!signal || !config || !thresholds || !outputs || count == 0) return -1;
+    if (length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+
+    int16_t* pyramid = (int16_t*)malloc(2 * length * sizeof(int16_t));
+    if (!pyramid) return -1;
+    int16_t* work = pyramid + length;
+
+    int levels = wavelet_decompose(signal, length, config, pyramid);
+    if (levels <= 0) {
+        free(pyramid);
+        return -1;
+    }
+
+    uint16_t pyramid_len = wavelet_band_offset(length, (uint8_t)levels, 1) + (length >> 1);
+
+    // Reference energy is the same for every entry, so compute it once.
+    double reference_energy = 0.0;
+    if (reference) {
+        for (uint16_t i = 0; i < length; i++) {
+            reference_energy += (double)reference[i] * reference[i];
+        }
+    }
+
+    wavelet_config_t entry_config = *config;
+    for (uint16_t c = 0; c < count; c++) {
+        int16_t* output = outputs + (size_t)c * length;
+        entry_config.threshold_type = thresholds[c].threshold_type;
+        entry_config.threshold_value = thresholds[c].threshold_value;
+        entry_config.per_level_thresholds = 0;
+
+        memcpy(work, pyramid, pyramid_len * sizeof(int16_t));
+        apply_band_modes(work, length, (uint8_t)levels, &entry_config);
+        wavelet_reconstruct(work, length, &entry_config, output);
+
+        if (reference && metrics_out) {
+            int64_t error_energy = 0;
+            for (uint16_t i = 0; i < length; i++) {
+                int32_t e = (int32_t)output[i] - reference[i];
+                error_energy += (int64_t)e * e;
+            }
+            metrics_out[c].mse = (double)error_energy / length;
+            metrics_out[c].snr_db = (error_energy > 0)
+                ? 10.0 * log10(reference_energy / (double)error_energy)
+                : INFINITY;
+        }
+    }
+
+    free(pyramid);
+    return levels;
+}
+
+// Offset of the intermediate approximation cA_k (1 <= k < levels) in the
+// incremental state's approximation buffers.
+static uint16_t incremental_approx_offset(uint16_t length, uint8_t k) {
+    uint16_t offset = 0;
+    for (uint8_t j = 1; j < k; j++) {
+        offset += length >> j;
+    }
+    return offset;
+}
+
+// Re-applies the band mode to raw[span] and writes the result to out. Most
+// rules are pointwise; neighbourhood rules also change the `radius`
+// coefficients on either side, so the span that actually changed is returned.
+static sample_span_t refresh_band_span(const int16_t* raw, int16_t* out, uint16_t n, uint8_t band,
+                                       const wavelet_config_t* config, sample_span_t span) {
+    wavelet_threshold_t threshold = band_threshold(config, band);
+    wavelet_band_mode_t mode = config->band_mode[band];
+    int thresholded = (mode == WAVELET_BAND_THRESHOLD) || (mode == WAVELET_BAND_DEFAULT && band != 0);
+
+    if (thresholded && is_neighbourhood_threshold(threshold.threshold_type)) {
+        uint8_t radius = config->neighbourhood_radius;
+        if (radius > WAVELET_MAX_NEIGHBOURHOOD_RADIUS) radius = WAVELET_MAX_NEIGHBOURHOOD_RADIUS;
+        sample_span_t grown = { span.start - radius, span.end + radius };
+        grown = clamp_span(grown, n);
+        threshold_neighbourhood_span(raw, out, n, grown.start, (uint16_t)(grown.end - grown.start),
+                                     threshold.threshold_type, threshold.threshold_value, config->neighbourhood_radius);
+        return grown;
+    }
+
+    for (int32_t c = span.start; c < span.end; c++) {
+        uint16_t i = wrap_index(c, n);
+        out[i] = raw[i];
+        apply_band_mode(&out[i], 1, band, config);
+    }
+    return span;
+}
+
+// Re-runs analysis, thresholding and synthesis for the cone of influence of
+// the changed input samples `changed` and updates state->output in place.
+static void incremental_refresh(wavelet_incremental_t* state, sample_span_t changed) {
+    const wavelet_config_t* config = &state->config;
+    uint16_t length = state->length;
+    uint8_t levels = state->levels;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    sample_span_t band_changed[MAX_DECOMPOSITION_LEVELS + 1];
+
+    // Analysis: push the change down the pyramid one cone at a time.
+    const int16_t* input = state->signal;
+    uint16_t n = length;
+    for (uint8_t k = 1; k <= levels; k++) {
+        uint16_t half = n >> 1;
+        sample_span_t span = analysis_cone(changed, kernel_len, half);
+        int16_t* approx = (k == levels) ? state->pyramid : state->approx + incremental_approx_offset(length, k);
+        int16_t* detail = state->pyramid + wavelet_band_offset(length, levels, k);
+        int16_t* detail_thr = state->thresholded + wavelet_band_offset(length, levels, k);
+
+        dwt_span(input, approx, detail, n, h0_kernel, h1_kernel, kernel_len, span.start, (uint16_t)(span.end - span.start));
+
+        band_changed[k] = refresh_band_span(detail, detail_thr, half, k, config, span);
+        changed = span;
+        input = approx;
+        n = half;
+    }
+
+    // Synthesis: the approximation feeding level k changed where either cA_k
+    // itself changed (from analysis) or the coarser reconstruction did.
+    uint16_t approx_len = length >> levels;
+    sample_span_t top = refresh_band_span(state->pyramid, state->thresholded, approx_len, 0, config, changed);
+
+    const int16_t* recon = state->thresholded;
+    sample_span_t recon_changed = top;
+    n = approx_len;
+    for (uint8_t k = levels; k >= 1; k--) {
+        uint16_t output_len = n << 1;
+        sample_span_t coeff_span = span_hull(recon_changed, band_changed[k], n);
+        sample_span_t out_span = synthesis_cone(coeff_span, kernel_len, output_len);
+        const int16_t* detail = state->thresholded + wavelet_band_offset(length, levels, k);
+        int16_t* output = (k == 1) ? state->output : state->recon + incremental_approx_offset(length, k - 1);
+
+        idwt_span(recon, detail, output, output_len, g0_kernel, g1_kernel, kernel_len,
+                  out_span.start, (uint16_t)(out_span.end - out_span.start));
+
+        recon_changed = out_span;
+        recon = output;
+        n = output_len;
+    }
+
+    state->dirty_start = wrap_index(recon_changed.start, length);
+    state->dirty_count = (uint16_t)(recon_changed.end - recon_changed.start);
+}
+
+int wavelet_incremental_init(wavelet_incremental_t* state, const int16_t* signal, uint16_t length, const wavelet_config_t* config) {
+    if (!state || !signal || !config || length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    if (levels == 0) return -1;
+
+    state->config = *config;
+    state->length = length;
+    state->levels = levels;
+    memcpy(state->signal, signal, length * sizeof(int16_t));
+
+    sample_span_t all = { 0, length };
+    incremental_refresh(state, all);
+    return levels;
+}
+
+int wavelet_incremental_update(wavelet_incremental_t* state, uint16_t start, const int16_t* samples, uint16_t count) {
+    if (!state || !samples || state->levels == 0) return -1;
+    if (count == 0 || (uint32_t)start + count > state->length) return -1;
+
+    memcpy(state->signal + start, samples, count * sizeof(int16_t));
+
+    sample_span_t changed = { start, (int32_t)start + count };
+    incremental_refresh(state, changed);
+    return 0;
+}
+
+static uint8_t dominant_tap(const int16_t* kernel, uint8_t kernel_len) {
+    uint8_t best = 0;
+    for (uint8_t j = 1; j < kernel_len; j++) {
+        if (abs(kernel[j]) > abs(kernel[best])) best = j;
+    }
+    return best;
+}
+
+// A cD_k coefficient i is dominated by sample (i << k) - offset, following
+// the largest h1 tap once and the largest h0 tap on every finer level.
+static int32_t spike_position_offset(const int16_t* h0_kernel, const int16_t* h1_kernel, uint8_t kernel_len, uint8_t k) {
+    int32_t half_scale = 1 << (k - 1);
+    return half_scale * dominant_tap(h1_kernel, kernel_len) + (half_scale - 1) * dominant_tap(h0_kernel, kernel_len);
+}
+
+static int is_spike_peak(int32_t prev_mag, int32_t mag, int32_t next_mag, int16_t threshold) {
+    return mag >= threshold && mag > prev_mag && mag >= next_mag;
+}
+
+int wavelet_detect_spikes(const int16_t* signal, uint16_t length, const wavelet_config_t* config,
+                          wavelet_spike_event_t* events_out, uint16_t max_events) {
+    if (!signal || !config || !events_out || length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    if (levels == 0) return -1;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    // Approximations ping-pong through the front of the scratch buffer; the
+    // current detail band and its magnitudes live in the back half.
+    int16_t* scratch = (int16_t*)malloc(2 * length * sizeof(int16_t));
+    if (!scratch) return -1;
+    int16_t* detail = scratch + length;
+    int16_t* magnitude = detail + (length >> 1);
+
+    uint16_t found = 0;
+    const int16_t* current_input = signal;
+    uint16_t current_n = length;
+    for (uint8_t k = 1; k <= levels; k++) {
+        uint16_t half = current_n >> 1;
+        int16_t* approx = scratch + ((k & 1) ? 0 : (length >> 1));
+        dwt_span(current_input, approx, detail, current_n, h0_kernel, h1_kernel, kernel_len, 0, half);
+
+        // Magnitudes first so the peak test below is a straight compare pass.
+        for (uint16_t i = 0; i < half; i++) {
+            int32_t mag = abs(detail[i]);
+            magnitude[i] = (int16_t)((mag > INT16_MAX) ? INT16_MAX : mag);
+        }
+
+        int32_t offset = spike_position_offset(h0_kernel, h1_kernel, kernel_len, k);
+        for (uint16_t i = 0; i < half; i++) {
+            int32_t prev_mag = magnitude[(i == 0) ? half - 1 : i - 1];
+            int32_t next_mag = magnitude[(i + 1 == half) ? 0 : i + 1];
+            if (!is_spike_peak(prev_mag, magnitude[i], next_mag, config->threshold_value)) continue;
+            if (found < max_events) {
+                events_out[found].index = wrap_index(((int32_t)i << k) - offset, length);
+                events_out[found].amplitude = detail[i];
+                events_out[found].scale = k;
+            }
+            found++;
+        }
+
+        current_input = approx;
+        current_n = half;
+    }
+
+    free(scratch);
+    return (found > max_events) ? max_events : found;
+}
+
+int wavelet_spike_stream_init(wavelet_spike_stream_t* stream, const wavelet_config_t* config) {
+    if (!stream || !config) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+
+    memset(stream, 0, sizeof(*stream));
+    stream->config = *config;
+    stream->levels = config->decomposition_levels;
+    return 0;
+}
+
+// Feeds one input sample into level k of the cascade. Every second input
+// produces one cD_k/cA_k pair from the last L inputs, which is exactly the
+// causal part of dwt(). cA_k is passed on to level k + 1 and cD_(k) is checked
+// for a peak one coefficient late, once its right neighbour is known.
+static void spike_stream_feed(wavelet_spike_stream_t* stream, uint8_t k, int16_t sample,
+                              const int16_t* h0_kernel, const int16_t* h1_kernel, uint8_t kernel_len,
+                              wavelet_spike_event_t* events_out, uint16_t max_events, uint16_t* found) {
+    wavelet_spike_level_t* level = &stream->level[k - 1];
+    level->history[level->inputs % kernel_len] = sample;
+    uint32_t input_index = level->inputs++;
+    if (input_index & 1) return;
+
+    int32_t approx_val = 0;
+    int32_t detail_val = 0;
+    for (uint8_t j = 0; j < kernel_len && j <= input_index; j++) {
+        int16_t x = level->history[(input_index - j) % kernel_len];
+        approx_val += (int32_t)x * h0_kernel[j];
+        detail_val += (int32_t)x * h1_kernel[j];
+    }
+    int16_t approx = round_kernel_acc(approx_val);
+    int16_t detail = round_kernel_acc(detail_val);
+    int32_t mag = abs(detail);
+    uint32_t coeff_index = input_index >> 1;
+
+    if (coeff_index >= 1 &&
+        is_spike_peak(level->prev_mag, level->last_mag, mag, stream->config.threshold_value)) {
+        if (*found < max_events) {
+            int32_t position = ((int32_t)(coeff_index - 1) << k) - spike_position_offset(h0_kernel, h1_kernel, kernel_len, k);
+            events_out[*found].index = (uint32_t)((position < 0) ? 0 : position);
+            events_out[*found].amplitude = level->last_detail;
+            events_out[*found].scale = k;
+        }
+        (*found)++;
+    }
+    level->prev_mag = level->last_mag;
+    level->last_mag = mag;
+    level->last_detail = detail;
+
+    if (k < stream->levels) {
+        spike_stream_feed(stream, k + 1, approx, h0_kernel, h1_kernel, kernel_len, events_out, max_events, found);
+    }
+}
+
+int wavelet_spike_stream_push(wavelet_spike_stream_t* stream, const int16_t* samples, uint16_t count,
+                              wavelet_spike_event_t* events_out, uint16_t max_events) {
+    if (!stream || !samples || !events_out || stream->levels == 0) return -1;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(stream->config.wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    uint16_t found = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        spike_stream_feed(stream, 1, samples[i], h0_kernel, h1_kernel, kernel_len, events_out, max_events, &found);
+    }
+    return (found > max_events) ? max_events : found;
+}
+
+// Magnitude histogram bins: values below 4 get a bin each, larger values get
+// four bins per octave (the two bits below the leading one).
+static uint8_t tracker_bin(int32_t magnitude) {
+    if (magnitude < 4) return (uint8_t)magnitude;
+    uint8_t octave = 2;
+    while ((magnitude >> (octave + 1)) != 0) octave++;
+    return (uint8_t)(4 * (octave - 1) + ((magnitude >> (octave - 2)) & 3));
+}
+
+static float tracker_bin_floor(uint8_t bin) {
+    if (bin < 4) return (float)bin;
+    uint8_t octave = (uint8_t)(bin / 4 + 1);
+    return (float)((4 + (bin & 3)) << (octave - 2));
+}
+
+void wavelet_tracker_init(wavelet_threshold_tracker_t* tracker, float decay, float multiplier,
+                          float smoothing, int16_t initial_threshold) {
+    if (!tracker) return;
+    memset(tracker, 0, sizeof(*tracker));
+    tracker->decay = decay;
+    tracker->multiplier = multiplier;
+    tracker->smoothing = smoothing;
+    tracker->weight = 1.0f;
+    tracker->threshold = (float)initial_threshold;
+}
+
+void wavelet_tracker_update(wavelet_threshold_tracker_t* tracker, const int16_t* coeffs, uint16_t count) {
+    if (!tracker || !coeffs || count == 0) return;
+
+    // Exponential forgetting without touching every bin: instead of decaying
+    // the histogram, each new sample is given a weight 1 / decay larger than
+    // the last, and the whole histogram is renormalized only when that
+    // weight grows too large.
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t magnitude = abs(coeffs[i]);
+        tracker->bins[tracker_bin(magnitude)] += tracker->weight;
+        tracker->total += tracker->weight;
+        tracker->weight /= tracker->decay;
+        if (tracker->weight > 1e20f) {
+            for (uint8_t b = 0; b < WAVELET_TRACKER_BINS; b++) {
+                tracker->bins[b] /= tracker->weight;
+            }
+            tracker->total /= tracker->weight;
+            tracker->weight = 1.0f;
+        }
+    }
+
+    // Median of |d| (the MAD of zero-mean detail coefficients), interpolated
+    // inside its bin.
+    float target = 0.5f * tracker->total;
+    float cumulative = 0.0f;
+    float mad = 0.0f;
+    for (uint8_t b = 0; b < WAVELET_TRACKER_BINS; b++) {
+        if (cumulative + tracker->bins[b] >= target && tracker->bins[b] > 0.0f) {
+            float lo = tracker_bin_floor(b);
+            float hi = (b + 1 < WAVELET_TRACKER_BINS) ? tracker_bin_floor((uint8_t)(b + 1)) : lo + 1.0f;
+            mad = lo + (hi - lo) * (target - cumulative) / tracker->bins[b];
+            break;
+        }
+        cumulative += tracker->bins[b];
+    }
+
+    // sigma = MAD / 0.6745 for Gaussian noise; move towards the new target
+    // by `smoothing` so that the threshold never jumps.
+    float goal = tracker->multiplier * mad / 0.6745f;
+    tracker->threshold += tracker->smoothing * (goal - tracker->threshold);
+}
+
+int16_t wavelet_tracker_threshold(const wavelet_threshold_tracker_t* tracker) {
+    if (!tracker) return 0;
+    float threshold = tracker->threshold + 0.5f;
+    if (threshold > (float)INT16_MAX) return INT16_MAX;
+    return (threshold > 0.0f) ? (int16_t)threshold : 0;
+}
+
+int wavelet_stream_init(wavelet_stream_t* stream, const wavelet_config_t* config, uint16_t frame_length) {
+    if (!stream || !config || frame_length == 0 || frame_length > MAX_SIGNAL_LENGTH) return -1;
+    if (wavelet_levels_for_length(frame_length, config) == 0) return -1;
+
+    memset(stream, 0, sizeof(*stream));
+    stream->config = *config;
+    stream->frame_length = frame_length;
+    return 0;
+}
+
+void wavelet_stream_set_adaptive(wavelet_stream_t* stream, float decay, float multiplier, float smoothing) {
+    if (!stream) return;
+    wavelet_tracker_init(&stream->tracker, decay, multiplier, smoothing, stream->config.threshold_value);
+    stream->adaptive = 1;
+}
+
+int wavelet_stream_process(wavelet_stream_t* stream, int16_t* frame) {
+    if (!stream || !frame || stream->frame_length == 0) return -1;
+
+    wavelet_config_t* config = &stream->config;
+    uint16_t length = stream->frame_length;
+    uint8_t levels = wavelet_levels_for_length(length, config);
+
+    int16_t pyramid[MAX_SIGNAL_LENGTH];
+    uint8_t active[MAX_DECOMPOSITION_LEVELS + 1];
+    memset(active, 1, sizeof(active));
+    if (decompose_bands(frame, length, config, levels, active, pyramid) != 0) return -1;
+
+    // The finest band is dominated by noise, so it drives the tracker.
+    if (stream->adaptive) {
+        wavelet_tracker_update(&stream->tracker, pyramid + wavelet_band_offset(length, levels, 1), length >> 1);
+        config->threshold_value = wavelet_tracker_threshold(&stream->tracker);
+        // Per-level thresholds keep their types but follow the tracked value.
+        for (uint8_t band = 1; band <= levels; band++) {
+            config->level_threshold[band].threshold_value = config->threshold_value;
+        }
+    }
+
+    apply_band_modes(pyramid, length, levels, config);
+    return reconstruct_bands(pyramid, length, config, levels, active, frame);
+}
+
+// Dual-tree complex wavelet transform. Tree A is the ordinary DWT. Tree B
+// analyses the signal advanced by one sample at level 1 and uses the
+// time-reversed filters below it, which shifts its sampling grid by about
+// half a coefficient relative to tree A at every level. Each tree is
+// orthonormal on its own, so averaging the two reconstructions is exact.
+// The trees run planar through dwt_span() / idwt_span(); bands are only
+// interleaved ([A0, B0, A1, B1, ...]) in the pyramid.
+
+static void dtcwt_interleave(const int16_t* tree_a, const int16_t* tree_b, int16_t* pairs, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        pairs[2 * i] = tree_a[i];
+        pairs[2 * i + 1] = tree_b[i];
+    }
+}
+
+static void dtcwt_deinterleave(const int16_t* pairs, int16_t* tree_a, int16_t* tree_b, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        tree_a[i] = pairs[2 * i];
+        tree_b[i] = pairs[2 * i + 1];
+    }
+}
+
+static int dtcwt_check_args(uint16_t length, const wavelet_config_t* config) {
+    if (!config || length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    if (config->decomposition_levels == 0 || config->decomposition_levels > MAX_DECOMPOSITION_LEVELS) return -1;
+    uint8_t levels = wavelet_levels_for_length(length, config);
+    return (levels == 0) ? -1 : levels;
+}
+
+int wavelet_dtcwt_decompose(const int16_t* signal, uint16_t length, const wavelet_config_t* config, int16_t* pyramid_out) {
+    if (!signal || !pyramid_out) return -1;
+    int levels = dtcwt_check_args(length, config);
+    if (levels < 0) return -1;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    // The advanced signal x[m + 1] for tree B, then per tree two
+    // half-length approximation buffers and one half-length detail band.
+    uint16_t half = length >> 1;
+    int16_t* scratch = (int16_t*)malloc(4 * (size_t)length * sizeof(int16_t));
+    if (!scratch) return -1;
+    int16_t* advanced = scratch;
+    for (uint16_t m = 0; m < length; m++) advanced[m] = signal[(m + 1) % length];
+
+    const int16_t* input[2] = { signal, advanced };
+    uint16_t current_n = length;
+    for (uint8_t k = 1; k <= levels; k++) {
+        int16_t* detail[2];
+        for (uint8_t tree = 0; tree < 2; tree++) {
+            int16_t* approx = scratch + length + (size_t)tree * length + ((k & 1) ? 0 : half);
+            detail[tree] = scratch + 3 * (size_t)length + (size_t)tree * half;
+            const int16_t* lo = (tree == 1 && k > 1) ? g0_kernel : h0_kernel;
+            const int16_t* hi = (tree == 1 && k > 1) ? g1_kernel : h1_kernel;
+            dwt_span(input[tree], approx, detail[tree], current_n, lo, hi, kernel_len, 0, current_n >> 1);
+            input[tree] = approx;
+        }
+        current_n >>= 1;
+        dtcwt_interleave(detail[0], detail[1], pyramid_out + 2 * wavelet_band_offset(length, levels, k), current_n);
+    }
+    dtcwt_interleave(input[0], input[1], pyramid_out, current_n);
+
+    free(scratch);
+    return levels;
+}
+
+int wavelet_dtcwt_reconstruct(const int16_t* pyramid, uint16_t length, const wavelet_config_t* config, int16_t* signal_out) {
+    if (!pyramid || !signal_out) return -1;
+    int levels = dtcwt_check_args(length, config);
+    if (levels < 0) return -1;
+
+    const int16_t* h0_kernel = NULL;
+    const int16_t* h1_kernel = NULL;
+    const int16_t* g0_kernel = NULL;
+    const int16_t* g1_kernel = NULL;
+    uint8_t kernel_len = 0;
+    get_wavelet_coeffs(config->wavelet, &h0_kernel, &h1_kernel, &g0_kernel, &g1_kernel, &kernel_len);
+
+    // Per tree two full-length ping-pong buffers and one half-length
+    // detail band.
+    uint16_t half = length >> 1;
+    int16_t* scratch = (int16_t*)malloc(5 * (size_t)length * sizeof(int16_t));
+    if (!scratch) return -1;
+    int16_t* buffers[2][2] = {
+        { scratch, scratch + length },
+        { scratch + 2 * (size_t)length, scratch + 3 * (size_t)length }
+    };
+    int16_t* detail[2] = { scratch + 4 * (size_t)length, scratch + 4 * (size_t)length + half };
+
+    uint16_t current_n = length >> levels;
+    uint8_t current = 0;
+    dtcwt_deinterleave(pyramid, buffers[0][0], buffers[1][0], current_n);
+
+    // Tree B synthesizes with the reverse of its analysis filters: h0/h1
+    // below level 1, g0/g1 at level 1 like tree A.
+    for (uint8_t k = (uint8_t)levels; k >= 1; k--) {
+        dtcwt_deinterleave(pyramid + 2 * wavelet_band_offset(length, levels, k), detail[0], detail[1], current_n);
+        for (uint8_t tree = 0; tree < 2; tree++) {
+            const int16_t* lo = (tree == 1 && k > 1) ? h0_kernel : g0_kernel;
+            const int16_t* hi = (tree == 1 && k > 1) ? h1_kernel : g1_kernel;
+            idwt_span(buffers[tree][current], detail[tree], buffers[tree][current ^ 1], current_n << 1,
+                      lo, hi, kernel_len, 0, current_n << 1);
+        }
+        current ^= 1;
+        current_n <<= 1;
+    }
+
+    // Tree B reconstructed the advanced signal: x[m] = yB[m - 1].
+    const int16_t* tree_a = buffers[0][current];
+    const int16_t* tree_b = buffers[1][current];
+    for (uint16_t m = 0; m < length; m++) {
+        int32_t sum = (int32_t)tree_a[m] + tree_b[(m + length - 1) % length];
+        signal_out[m] = (int16_t)((sum >= 0) ? (sum + 1) >> 1 : -((-sum + 1) >> 1));
+    }
+
+    free(scratch);
+    return levels;
+}
+
+// apply_band_mode() on complex magnitudes, which reach sqrt(2) * 32768 and
+// are therefore kept in 32 bits. Magnitudes are never negative.
+static void dtcwt_shrink_magnitudes(int32_t* magnitudes, uint16_t count, uint8_t band, const wavelet_config_t* config) {
+    wavelet_threshold_t threshold = band_threshold(config, band);
+    int32_t t = threshold.threshold_value;
+
+    switch (config->band_mode[band]) {
+        case WAVELET_BAND_DEFAULT:
+            if (band == 0) return;
+            break;
+        case WAVELET_BAND_THRESHOLD:
+            break;
+        case WAVELET_BAND_ZERO:
+            memset(magnitudes, 0, count * sizeof(int32_t));
+            return;
+        case WAVELET_BAND_SCALE:
+            for (uint16_t i = 0; i < count; i++) {
+                magnitudes[i] = (int32_t)(((int64_t)magnitudes[i] * config->band_gain[band] + (1 << (KERNEL_Q - 1))) >> KERNEL_Q);
+            }
+            return;
+        case WAVELET_BAND_KEEP:
+        default:
+            return;
+    }
+
+    if (is_neighbourhood_threshold(threshold.threshold_type)) {
+        // Same sliding neighbourhood as threshold_neighbourhood_span(), with
+        // 64-bit energies over the unmodified magnitudes.
+        int32_t* raw = (int32_t*)malloc(count * sizeof(int32_t));
+        if (!raw) return;
+        memcpy(raw, magnitudes, count * sizeof(int32_t));
+        uint8_t radius = config->neighbourhood_radius;
+        if (radius > WAVELET_MAX_NEIGHBOURHOOD_RADIUS) radius = WAVELET_MAX_NEIGHBOURHOOD_RADIUS;
+        if (2 * radius + 1 > count) radius = (uint8_t)((count - 1) / 2);
+        int64_t limit = (int64_t)t * t * (2 * radius + 1);
+        int64_t energy = 0;
+        for (int32_t j = -radius; j <= radius; j++) {
+            int64_t v = raw[wrap_index(j, count)];
+            energy += v * v;
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            if (threshold.threshold_type == THRESHOLD_BLOCK) {
+                magnitudes[i] = (energy >= limit) ? raw[i] : 0;
+            } else {
+                magnitudes[i] = (energy > limit) ? (int32_t)(((int64_t)raw[i] * (energy - limit)) / energy) : 0;
+            }
+            int64_t enter = raw[wrap_index(i + radius + 1, count)];
+            int64_t leave = raw[wrap_index(i - radius, count)];
+            energy += enter * enter - leave * leave;
+        }
+        free(raw);
+        return;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t m = magnitudes[i];
+        switch (threshold.threshold_type) {
+            case THRESHOLD_HARD: magnitudes[i] = (m < t) ? 0 : m; break;
+            case THRESHOLD_SOFT: magnitudes[i] = (m < t) ? 0 : m - t; break;
+            case THRESHOLD_ZERO: magnitudes[i] = 0; break;
+            case THRESHOLD_SPIKE: magnitudes[i] = (m >= t) ? 0 : m; break;
+            default: break;
+        }
+    }
+}
+
+// Applies the band's mode to the complex magnitudes |A + iB| and rescales
+// both trees by the resulting gain, so phase is preserved.
+static void dtcwt_apply_band_mode(int16_t* pairs, uint16_t count, uint8_t band, const wavelet_config_t* config) {
+    int32_t* magnitudes = (int32_t*)malloc(2 * (size_t)count * sizeof(int32_t));
+    if (!magnitudes) return;
+    int32_t* shrunk = magnitudes + count;
+
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t a = pairs[2 * i];
+        int32_t b = pairs[2 * i + 1];
+        magnitudes[i] = (int32_t)lround(sqrt((double)a * a + (double)b * b));
+    }
+    memcpy(shrunk, magnitudes, count * sizeof(int32_t));
+    dtcwt_shrink_magnitudes(shrunk, count, band, config);
+
+    for (uint16_t i = 0; i < count; i++) {
+        if (shrunk[i] == magnitudes[i]) continue;
+        if (magnitudes[i] == 0) continue;
+        for (uint8_t tree = 0; tree < 2; tree++) {
+            int64_t scaled = (int64_t)pairs[2 * i + tree] * shrunk[i];
+            int64_t half = magnitudes[i] / 2;
+            pairs[2 * i + tree] = saturate_int16((int32_t)((scaled >= 0 ? scaled + half : scaled - half) / magnitudes[i]));
+        }
+    }
+    free(magnitudes);
+}
+
+void wavelet_dtcwt_filter(int16_t* signal, uint16_t length, const wavelet_config_t* config) {
+    if (!signal || dtcwt_check_args(length, config) < 0) return;
+
+    int16_t* pyramid = (int16_t*)malloc(2 * (size_t)length * sizeof(int16_t));
+    if (!pyramid) return;
+
+    int levels = wavelet_dtcwt_decompose(signal, length, config, pyramid);
+    if (levels > 0) {
+        for (uint8_t band = 0; band <= levels; band++) {
+            dtcwt_apply_band_mode(pyramid + 2 * wavelet_band_offset(length, levels, band),
+                                  wavelet_band_length(length, levels, band), band, config);
+        }
+        wavelet_dtcwt_reconstruct(pyramid, length, config, signal);
+    }
+    free(pyramid);
 }
@@ -3,8 +3,8 @@
  * @brief Public API for an advanced wavelet-based filtering library.
  *
  * This file defines the public interface for a configurable fixed-point
- * wavelet filter. It supports multiple wavelet families (Daubechies, Haar)
- * and thresholding strategies, making it adaptable for various signal
+ * wavelet filter. It supports multiple wavelet families (Daubechies, Symlet,
+ * Coiflet, Haar) and thresholding strategies, making it adaptable for various signal
  * processing applications in embedded systems.
  */
 
@@ -27,15 +27,77 @@
 /**
  * @brief Maximum length of a wavelet coefficient kernel.
  */
-#define MAX_WAVELET_KERNEL_LENGTH 12
+#define MAX_WAVELET_KERNEL_LENGTH 64
+
+/**
+ * @brief Maximum number of filter banks registered with wavelet_register_custom().
+ */
+#define WAVELET_MAX_CUSTOM 16
+
+/**
+ * @brief Frames filtered side by side by wavelet_filter_batch().
+ *
+ * Eight 32-bit accumulators fill one 256-bit vector register.
+ */
+#define WAVELET_BATCH_LANES 8
 
 /**
  * @brief Enumeration for supported wavelet types.
+ *
+ * WAVELET_DB4 and WAVELET_DB6 are named after their tap counts; the family
+ * entries are named after the number of vanishing moments, so
+ * WAVELET_DAUBECHIES_2 is the same filter as WAVELET_DB4. Values from
+ * WAVELET_CUSTOM_FIRST on are handles returned by wavelet_register_custom().
  */
 typedef enum {
+    WAVELET_INVALID = -1,
     WAVELET_DB4,
     WAVELET_DB6,
-    WAVELET_HAAR
+    WAVELET_HAAR,
+    WAVELET_DAUBECHIES_2,  ///< db2 .. db20: 2N taps.
+    WAVELET_DAUBECHIES_3,
+    WAVELET_DAUBECHIES_4,
+    WAVELET_DAUBECHIES_5,
+    WAVELET_DAUBECHIES_6,
+    WAVELET_DAUBECHIES_7,
+    WAVELET_DAUBECHIES_8,
+    WAVELET_DAUBECHIES_9,
+    WAVELET_DAUBECHIES_10,
+    WAVELET_DAUBECHIES_11,
+    WAVELET_DAUBECHIES_12,
+    WAVELET_DAUBECHIES_13,
+    WAVELET_DAUBECHIES_14,
+    WAVELET_DAUBECHIES_15,
+    WAVELET_DAUBECHIES_16,
+    WAVELET_DAUBECHIES_17,
+    WAVELET_DAUBECHIES_18,
+    WAVELET_DAUBECHIES_19,
+    WAVELET_DAUBECHIES_20,
+    WAVELET_SYMLET_2,      ///< sym2 .. sym20: 2N taps, near-linear phase.
+    WAVELET_SYMLET_3,
+    WAVELET_SYMLET_4,
+    WAVELET_SYMLET_5,
+    WAVELET_SYMLET_6,
+    WAVELET_SYMLET_7,
+    WAVELET_SYMLET_8,
+    WAVELET_SYMLET_9,
+    WAVELET_SYMLET_10,
+    WAVELET_SYMLET_11,
+    WAVELET_SYMLET_12,
+    WAVELET_SYMLET_13,
+    WAVELET_SYMLET_14,
+    WAVELET_SYMLET_15,
+    WAVELET_SYMLET_16,
+    WAVELET_SYMLET_17,
+    WAVELET_SYMLET_18,
+    WAVELET_SYMLET_19,
+    WAVELET_SYMLET_20,
+    WAVELET_COIFLET_1,     ///< coif1 .. coif5: 6N taps.
+    WAVELET_COIFLET_2,
+    WAVELET_COIFLET_3,
+    WAVELET_COIFLET_4,
+    WAVELET_COIFLET_5,
+    WAVELET_CUSTOM_FIRST = 64
 } wavelet_type_t;
 
 /**
@@ -44,9 +106,51 @@ typedef enum {
 typedef enum {
     THRESHOLD_HARD,
     THRESHOLD_SOFT,
-    THRESHOLD_ZERO // Special case to zero out coefficients
+    THRESHOLD_ZERO, // Special case to zero out coefficients
+    THRESHOLD_SPIKE, // Zero outliers at or above the threshold (spike suppression)
+    THRESHOLD_BLOCK, // Keep coefficients whose neighbourhood mean energy reaches threshold^2
+    THRESHOLD_BLOCK_JS // James-Stein shrinkage by neighbourhood energy
 } threshold_type_t;
 
+/**
+ * @brief Per-band processing modes (see wavelet_config_t::band_mode).
+ */
+typedef enum {
+    WAVELET_BAND_DEFAULT,   ///< Threshold detail bands, keep the approximation.
+    WAVELET_BAND_KEEP,      ///< Pass the band through unchanged.
+    WAVELET_BAND_THRESHOLD, ///< Apply threshold_type/threshold_value (also to cA_n).
+    WAVELET_BAND_ZERO,      ///< Drop the band; it is not computed at all.
+    WAVELET_BAND_SCALE      ///< Multiply the band by band_gain (Q14).
+} wavelet_band_mode_t;
+
+/**
+ * @brief Per-band statistics produced by wavelet_extract_features().
+ *
+ * The values index into the block of WAVELET_FEATURES_PER_BAND entries
+ * reported for each detail band.
+ */
+typedef enum {
+    WAVELET_FEATURE_ENERGY,         ///< Sum of squared coefficients.
+    WAVELET_FEATURE_MEAN_ABS,       ///< Mean absolute coefficient value.
+    WAVELET_FEATURE_ENTROPY,        ///< Shannon entropy (nats) of the normalized energy distribution.
+    WAVELET_FEATURE_ZERO_CROSSINGS, ///< Sign changes between consecutive non-zero coefficients.
+    WAVELET_FEATURE_MAX_ABS,        ///< Largest coefficient magnitude.
+    WAVELET_FEATURES_PER_BAND
+} wavelet_feature_t;
+
+/**
+ * @brief Length of the fixed-size feature vector produced per signal.
+ */
+#define WAVELET_FEATURE_VECTOR_LENGTH (MAX_DECOMPOSITION_LEVELS * WAVELET_FEATURES_PER_BAND)
+
+/**
+ * @brief A thresholding strategy together with its threshold.
+ */
+typedef struct {
+    threshold_type_t threshold_type;  ///< Thresholding strategy.
+    int16_t threshold_value;          ///< Threshold for coefficient filtering.
+} wavelet_threshold_t;
+
 /**
  * @brief Configuration structure for the wavelet filter.
  *
@@ -58,9 +162,279 @@ typedef struct {
     threshold_type_t threshold_type;  ///< Thresholding strategy.
     uint8_t decomposition_levels;   ///< Number of DWT levels.
     int16_t threshold_value;        ///< Threshold for coefficient filtering.
-    uint16_t q_format;              ///< Q-format for fixed-point arithmetic.
+    uint16_t q_format;              ///< Q-format of the signal samples (kernels are Q14 internally).
+    /**
+     * Per-band modes, indexed like wavelet_band_offset(): entry 0 is the final
+     * approximation cA_n and entry k the detail band cD_k. Bands that end up
+     * zeroed are skipped in both decomposition and reconstruction, which makes
+     * band-pass and band-stop configurations cheaper than a full filter.
+     */
+    wavelet_band_mode_t band_mode[MAX_DECOMPOSITION_LEVELS + 1];
+    int16_t band_gain[MAX_DECOMPOSITION_LEVELS + 1]; ///< Q14 gains for WAVELET_BAND_SCALE.
+    /**
+     * Non-zero to threshold each band with its own entry of level_threshold
+     * (indexed like band_mode) instead of threshold_type/threshold_value.
+     */
+    uint8_t per_level_thresholds;
+    wavelet_threshold_t level_threshold[MAX_DECOMPOSITION_LEVELS + 1];
+    uint8_t neighbourhood_radius;   ///< Half-width r of the 2r + 1 window used by block thresholding.
 } wavelet_config_t;
 
+/**
+ * @brief Quality metrics reported for one entry of a parameter sweep.
+ */
+typedef struct {
+    double mse;     ///< Mean squared error against the reference.
+    double snr_db;  ///< Reference energy over error energy, in dB (INFINITY if exact).
+} wavelet_sweep_metrics_t;
+
+/**
+ * @brief State for incremental filtering of a signal under localized edits.
+ *
+ * Keeps the raw and thresholded coefficient pyramids plus every intermediate
+ * approximation so an edit only recomputes the coefficients in the cone of
+ * influence of the changed samples. All storage is inline; the structure
+ * should be treated as opaque apart from the fields documented below.
+ */
+typedef struct {
+    wavelet_config_t config;
+    uint16_t length;
+    uint8_t levels;
+    uint16_t dirty_start;                    ///< First output sample refreshed by the last call.
+    uint16_t dirty_count;                    ///< Number of output samples refreshed (wraps modulo length).
+    int16_t signal[MAX_SIGNAL_LENGTH];       ///< Current input signal.
+    int16_t output[MAX_SIGNAL_LENGTH];       ///< Current filtered signal.
+    int16_t pyramid[MAX_SIGNAL_LENGTH];      ///< Unthresholded Mallat-order pyramid.
+    int16_t thresholded[MAX_SIGNAL_LENGTH];  ///< Thresholded pyramid used for synthesis.
+    int16_t approx[MAX_SIGNAL_LENGTH];       ///< Analysis approximations cA_1 .. cA_(n-1).
+    int16_t recon[MAX_SIGNAL_LENGTH];        ///< Synthesis approximations for levels 1 .. n-1.
+} wavelet_incremental_t;
+
+/**
+ * @brief A spike or transient located in a detail band.
+ */
+typedef struct {
+    uint32_t index;     ///< Sample index the coefficient is centred on.
+    int16_t amplitude;  ///< Signed detail coefficient at the peak.
+    uint8_t scale;      ///< Detail level k of the band (1 is the finest).
+} wavelet_spike_event_t;
+
+/**
+ * @brief Per-level state of a streaming spike detector.
+ */
+typedef struct {
+    int16_t history[MAX_WAVELET_KERNEL_LENGTH]; ///< Last L inputs to this level.
+    uint32_t inputs;                            ///< Number of inputs seen so far.
+    int32_t prev_mag;                           ///< |cD| two coefficients back.
+    int32_t last_mag;                           ///< |cD| of the pending coefficient.
+    int16_t last_detail;                        ///< Signed value of the pending coefficient.
+} wavelet_spike_level_t;
+
+/**
+ * @brief State of a streaming spike detector (see wavelet_spike_stream_push()).
+ */
+typedef struct {
+    wavelet_config_t config;
+    uint8_t levels;
+    wavelet_spike_level_t level[MAX_DECOMPOSITION_LEVELS];
+} wavelet_spike_stream_t;
+
+/**
+ * @brief Number of magnitude bins kept by wavelet_threshold_tracker_t.
+ */
+#define WAVELET_TRACKER_BINS 64
+
+/**
+ * @brief Adaptive threshold that follows the noise floor of a stream.
+ *
+ * Tracks the median absolute value of detail coefficients with an
+ * exponentially decaying histogram (four bins per octave), which costs O(1)
+ * per coefficient and keeps no history. The threshold is
+ * `multiplier * MAD / 0.6745` and moves towards that target by `smoothing`
+ * on every update.
+ */
+typedef struct {
+    float bins[WAVELET_TRACKER_BINS];
+    float total;
+    float weight;
+    float decay;
+    float multiplier;
+    float smoothing;
+    float threshold;
+} wavelet_threshold_tracker_t;
+
+/**
+ * @brief Frame-by-frame streaming filter (see wavelet_stream_process()).
+ */
+typedef struct {
+    wavelet_config_t config;
+    uint16_t frame_length;
+    uint8_t adaptive;
+    wavelet_threshold_tracker_t tracker;
+} wavelet_stream_t;
+
+/**
+ * @brief Receives a frame filtered by a wavelet_aggregator_t.
+ *
+ * @param user The pointer given to wavelet_aggregator_init().
+ * @param stream_id The id the frame was submitted with.
+ * @param frame The submitted buffer, now holding the filtered frame.
+ * @param status 0 if the frame was filtered, or -1 if the batch failed and
+ *               the frame is handed back unfiltered.
+ */
+typedef void (*wavelet_frame_callback_t)(void* user, uint32_t stream_id, int16_t* frame, int status);
+
+/**
+ * @brief Batches frames from independent streams into lane-parallel filtering.
+ *
+ * Streams submit frames whenever they are ready; a batch runs as soon as
+ * WAVELET_BATCH_LANES frames are pending or the oldest pending frame has
+ * waited `max_delay_us`. Not thread-safe: submit and poll from one thread.
+ */
+typedef struct {
+    wavelet_config_t config;
+    uint16_t frame_length;
+    uint64_t max_delay_us;
+    wavelet_frame_callback_t deliver;
+    void* user;
+    uint8_t pending;                          ///< Frames waiting for the next batch.
+    uint64_t oldest_us;                       ///< Submission time of the first pending frame.
+    uint32_t stream_ids[WAVELET_BATCH_LANES];
+    int16_t* frames[WAVELET_BATCH_LANES];
+    uint64_t batches;                         ///< Batches run so far.
+    uint64_t frames_filtered;                 ///< Frames delivered filtered so far.
+    uint64_t frames_failed;                   ///< Frames delivered unfiltered after a failed batch.
+} wavelet_aggregator_t;
+
+/**
+ * @brief Assumed cache line size, used to keep ring indices apart.
+ */
+#define WAVELET_CACHE_LINE 64
+
+/**
+ * @brief Lock-free single-producer/single-consumer sample ring.
+ *
+ * The producer and consumer indices live on separate cache lines, and each
+ * side keeps a cached copy of the other's index so it only touches the
+ * shared line when its cached view runs out. The producer publishes its
+ * index once per `publish_batch` samples (or on wavelet_ring_publish()),
+ * so a steady stream costs one shared store per batch instead of one per
+ * push. Indices are free-running 32-bit counters.
+ */
+typedef struct {
+    int16_t* buffer;
+    uint32_t mask;                 ///< capacity - 1 (capacity is a power of two).
+    uint32_t publish_batch;
+    uint8_t pad0[WAVELET_CACHE_LINE];
+    uint32_t head;                 ///< Published write index (producer stores, consumer loads).
+    uint8_t pad1[WAVELET_CACHE_LINE];
+    uint32_t tail;                 ///< Read index (consumer stores, producer loads).
+    uint8_t pad2[WAVELET_CACHE_LINE];
+    uint32_t write_index;          ///< Producer-private: written but maybe unpublished.
+    uint32_t cached_tail;          ///< Producer-private view of tail.
+    uint8_t pad3[WAVELET_CACHE_LINE];
+    uint32_t cached_head;          ///< Consumer-private view of head.
+    uint8_t pad4[WAVELET_CACHE_LINE];
+} wavelet_ring_t;
+
+/**
+ * @brief How wavelet_filter_long() and wavelet_pipeline_run() extend the signal past its ends.
+ */
+typedef enum {
+    WAVELET_EXTEND_ZERO,      ///< Zeros on both sides.
+    WAVELET_EXTEND_SYMMETRIC  ///< Half-sample mirror: x[-1 - i] = x[i].
+} wavelet_extension_t;
+
+/**
+ * @brief Stages and I/O of an offline filtering pipeline (see wavelet_pipeline_run()).
+ */
+typedef struct {
+    uint32_t block_length;  ///< Output samples per block, rounded down to a multiple of 2^levels.
+    uint8_t num_workers;    ///< Filtering threads (0 means 1).
+    uint16_t num_buffers;   ///< Blocks in flight (0 means 4 per worker); bounds memory and reordering.
+    wavelet_extension_t extension; ///< Boundary extension of the stream.
+    /**
+     * Reads up to `max_count` samples; returns how many (0 at the end of
+     * the input) or -1 on error. Called from the reader thread only.
+     */
+    int32_t (*read)(void* io, int16_t* samples, uint32_t max_count);
+    /**
+     * Writes `count` samples; returns 0 on success or -1 on error. Called
+     * from the caller's thread only, in input order.
+     */
+    int (*write)(void* io, const int16_t* samples, uint32_t count);
+    void* read_io;          ///< Passed to read.
+    void* write_io;         ///< Passed to write.
+} wavelet_pipeline_config_t;
+
+/**
+ * @brief Requests a filtering service can hold in flight across all clients.
+ */
+#define WAVELET_SERVICE_SLOTS 64
+
+/**
+ * @brief Longest a service request waits for a slot and its answer.
+ */
+#define WAVELET_SERVICE_TIMEOUT_MS 5000
+
+/**
+ * @brief A running local filtering service (see wavelet_service_start()).
+ */
+typedef struct wavelet_service wavelet_service_t;
+
+/**
+ * @brief A process's connection to a local filtering service.
+ */
+typedef struct wavelet_client wavelet_client_t;
+
+/**
+ * @brief Configuration for wavelet_filter_long().
+ */
+typedef struct {
+    wavelet_extension_t extension; ///< Boundary extension of the signal.
+    uint8_t num_threads;           ///< Worker threads (0 or 1 runs on the caller's thread).
+    uint32_t block_length;         ///< Output samples per block, 0 to size windows to half of L2.
+} wavelet_long_config_t;
+
+/**
+ * @brief Mother wavelets available to wavelet_cwt().
+ */
+typedef enum {
+    WAVELET_CWT_MORLET,      ///< Complex Morlet; parameter is omega0 (6 if <= 0).
+    WAVELET_CWT_MEXICAN_HAT, ///< Second derivative of a Gaussian; parameter unused.
+    WAVELET_CWT_PAUL         ///< Complex Paul; parameter is the order m (4 if <= 0).
+} wavelet_cwt_family_t;
+
+/**
+ * @brief Configuration for wavelet_cwt().
+ */
+typedef struct {
+    wavelet_cwt_family_t family;
+    float parameter;     ///< Family parameter, see wavelet_cwt_family_t.
+    uint8_t num_threads; ///< Threads sharing the scales; 0 or 1 runs on the caller's thread.
+} wavelet_cwt_config_t;
+
+/**
+ * @brief Registers an orthogonal filter bank from its low-pass analysis filter.
+ *
+ * The high-pass filter is derived as h1[k] = (-1)^k h0[L-1-k] and the
+ * synthesis filters as the time reverses of h0 and h1. The filter must be
+ * orthonormal (unit energy, orthogonal to its even shifts, DC gain
+ * sqrt(2)) within the precision of the Q14 kernels, and the sum of its
+ * absolute taps must stay below 4 so that full-scale input cannot overflow
+ * the 32-bit accumulators. The returned handle can
+ * be used anywhere a wavelet_type_t is accepted and runs through the same
+ * kernels as the built-in wavelets. Registration is not thread-safe and
+ * should happen before filtering starts.
+ *
+ * @param[in] h0 The low-pass analysis taps.
+ * @param[in] len The number of taps (even, at most MAX_WAVELET_KERNEL_LENGTH).
+ * @param[in] q_format The Q-format of the taps (0..15).
+ * @return The new wavelet handle, or WAVELET_INVALID if the filter is
+ *         rejected or the registry is full.
+ */
+wavelet_type_t wavelet_register_custom(const int16_t* h0, uint8_t len, uint16_t q_format);
+
 /**
  * @brief Initializes the wavelet filter configuration with default values.
  *
@@ -97,6 +471,302 @@ void idwt(const int16_t* approx_coeffs, const int16_t* detail_coeffs, int16_t* o
  */
 void apply_thresholding(int16_t* coeffs, uint16_t length, const wavelet_config_t* config);
 
+/**
+ * @brief Returns the number of levels a decomposition of `length` samples
+ * will actually perform.
+ *
+ * Decomposition stops early once the approximation is shorter than the
+ * wavelet kernel, so this may be less than `config->decomposition_levels`.
+ *
+ * @param[in] length The length of the signal.
+ * @param[in] config The filter configuration.
+ * @return The effective number of levels (0 if none can be performed).
+ */
+uint8_t wavelet_levels_for_length(uint16_t length, const wavelet_config_t* config);
+
+/**
+ * @brief Returns the number of taps of a wavelet's filters.
+ *
+ * @param[in] wavelet A built-in wavelet or a registered custom handle.
+ * @return The kernel length.
+ */
+uint8_t wavelet_kernel_length(wavelet_type_t wavelet);
+
+/**
+ * @brief Returns the offset of a band inside a Mallat-order pyramid.
+ *
+ * Pyramids produced by wavelet_decompose() are laid out as
+ * [cA_n, cD_n, cD_(n-1), ..., cD_1] in one contiguous buffer. Band 0 is the
+ * final approximation cA_n; band k (1..n) is the detail band cD_k, with cD_1
+ * the finest scale. cA_n holds `length >> n` coefficients and cD_k holds
+ * `length >> k`, so for lengths divisible by 2^n cD_k starts at `length >> k`.
+ *
+ * @param[in] length The length of the original signal.
+ * @param[in] levels The effective number of levels (see wavelet_levels_for_length()).
+ * @param[in] band The band index (0 for cA_n, k for cD_k).
+ * @return The offset of the first coefficient of the band.
+ */
+uint16_t wavelet_band_offset(uint16_t length, uint8_t levels, uint8_t band);
+
+/**
+ * @brief Returns the number of coefficients in a band of a Mallat-order pyramid.
+ *
+ * @param[in] length The length of the original signal.
+ * @param[in] levels The effective number of levels.
+ * @param[in] band The band index (0 for cA_n, k for cD_k).
+ * @return The number of coefficients in the band.
+ */
+uint16_t wavelet_band_length(uint16_t length, uint8_t levels, uint8_t band);
+
+/**
+ * @brief Performs a multi-level decomposition without reconstruction.
+ *
+ * The coefficient pyramid is written to `pyramid_out` in Mallat order
+ * ([cA_n, cD_n, ..., cD_1], see wavelet_band_offset()). The buffer must hold
+ * at least `length` coefficients. No thresholding is applied.
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal.
+ * @param[in] config The configuration (wavelet and levels are used).
+ * @param[out] pyramid_out Caller-provided buffer for the coefficient pyramid.
+ * @return The effective number of levels, or -1 on invalid arguments.
+ */
+int wavelet_decompose(const int16_t* signal, uint16_t length, const wavelet_config_t* config, int16_t* pyramid_out);
+
+/**
+ * @brief Reconstructs a signal from a Mallat-order coefficient pyramid.
+ *
+ * This is the inverse of wavelet_decompose(). The pyramid is not modified,
+ * so it can be thresholded or inspected by the caller beforehand.
+ *
+ * @param[in] pyramid Pointer to the coefficient pyramid.
+ * @param[in] length The length of the original signal.
+ * @param[in] config The configuration used for the decomposition.
+ * @param[out] signal_out Buffer receiving `length` reconstructed samples.
+ * @return The effective number of levels, or -1 on invalid arguments.
+ */
+int wavelet_reconstruct(const int16_t* pyramid, uint16_t length, const wavelet_config_t* config, int16_t* signal_out);
+
+/**
+ * @brief Splits a signal into additive multiresolution components.
+ *
+ * Writes `levels + 1` rows of `length` samples to `components_out`: rows
+ * 0 .. levels - 1 are the details D1 .. Dn (D1 the finest) and row
+ * `levels` is the approximation An. The rows sum to the signal exactly;
+ * each one is within a few LSB of reconstructing its band alone. All
+ * components come from one decomposition, without a reconstruction per
+ * component.
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal.
+ * @param[in] config The configuration (wavelet and levels are used).
+ * @param[out] components_out Buffer of `(levels + 1) * length` samples,
+ *             sized for `config->decomposition_levels + 1` rows when the
+ *             effective depth is not known in advance.
+ * @return The effective number of levels, or -1 on invalid arguments or
+ *         allocation failure.
+ */
+int wavelet_mra(const int16_t* signal, uint16_t length, const wavelet_config_t* config, int16_t* components_out);
+
+/**
+ * @brief Decomposes a signal in place into the Mallat pyramid layout.
+ *
+ * Produces exactly what wavelet_decompose() writes to its output buffer,
+ * but overwrites the signal instead, using only a fixed-size stack ring
+ * of O(MAX_WAVELET_KERNEL_LENGTH) samples. Lengths above
+ * MAX_SIGNAL_LENGTH are accepted.
+ *
+ * @param[in,out] signal The signal on entry, the pyramid on return.
+ * @param[in] length The length of the signal.
+ * @param[in] config The configuration (wavelet and levels are used).
+ * @return The effective number of levels, or -1 on invalid arguments.
+ */
+int wavelet_decompose_inplace(int16_t* signal, uint16_t length, const wavelet_config_t* config);
+
+/**
+ * @brief In-place inverse of wavelet_decompose_inplace().
+ *
+ * @param[in,out] pyramid The pyramid on entry, the signal on return.
+ * @param[in] length The length of the signal.
+ * @param[in] config The configuration used for the decomposition.
+ * @return The effective number of levels, or -1 on invalid arguments.
+ */
+int wavelet_reconstruct_inplace(int16_t* pyramid, uint16_t length, const wavelet_config_t* config);
+
+/**
+ * @brief wavelet_filter() without a pyramid or reconstruction buffer.
+ *
+ * Decomposes in place, applies the band modes and reconstructs in place,
+ * so peak memory is the signal buffer plus a small stack ring. The
+ * neighbourhood threshold types still copy one band while thresholding
+ * it. Results match wavelet_filter() except for THRESHOLD_SPIKE, whose
+ * patching shortcut is not used here.
+ *
+ * @param[in,out] signal Pointer to the signal buffer.
+ * @param[in] length The length of the signal (any length the levels allow).
+ * @param[in] config The configuration for the filtering process.
+ */
+void wavelet_filter_inplace(int16_t* signal, uint16_t length, const wavelet_config_t* config);
+
+/**
+ * @brief Decomposes a long signal depth-first, one cache-sized block at a time.
+ *
+ * Every block of the signal is pushed through all levels before the next
+ * one is read, carrying an (L - 1)-sample history per level between
+ * blocks, so the signal is read once and the pyramid written once. The
+ * result equals wavelet_decompose() (periodic boundaries, Mallat layout)
+ * for any length; band k starts at `(length >> levels) + sum of
+ * (length >> j)` for j = levels .. k + 1, as in wavelet_band_offset().
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal; levels stop before the
+ *            length stops being divisible by two.
+ * @param[in] config The configuration (wavelet and levels are used).
+ * @param[out] pyramid_out Buffer of `length` coefficients.
+ * @return The effective number of levels, or -1 on invalid arguments or
+ *         allocation failure.
+ */
+int wavelet_decompose_blocked(const int16_t* signal, uint32_t length, const wavelet_config_t* config, int16_t* pyramid_out);
+
+/**
+ * @brief Depth-first inverse of wavelet_decompose_blocked().
+ *
+ * Each level produces its output in chunks a few coefficients ahead of the
+ * level below, so the pyramid is read once and the signal written once.
+ *
+ * @param[in] pyramid The coefficient pyramid.
+ * @param[in] length The length of the original signal.
+ * @param[in] config The configuration used for the decomposition.
+ * @param[out] signal_out Buffer receiving `length` samples.
+ * @return The effective number of levels, or -1 on invalid arguments or
+ *         allocation failure.
+ */
+int wavelet_reconstruct_blocked(const int16_t* pyramid, uint32_t length, const wavelet_config_t* config, int16_t* signal_out);
+
+/**
+ * @brief Downsamples a signal by 2^levels through the approximation path only.
+ *
+ * Runs the h0 branch of the depth-first cascade (see
+ * wavelet_decompose_blocked()) and never computes a detail coefficient,
+ * giving a cheap anti-aliased decimator. The output is exactly the cA_n
+ * band of the decomposition, so it carries the orthonormal gain of
+ * sqrt(2) per level.
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal.
+ * @param[in] config The configuration (wavelet and levels are used).
+ * @param[out] approx_out Buffer receiving `length >> levels` samples.
+ * @return The number of levels performed (the decimation factor is
+ *         2^levels), or -1 on invalid arguments or allocation failure.
+ */
+int wavelet_decimate(const int16_t* signal, uint32_t length, const wavelet_config_t* config, int16_t* approx_out);
+
+/**
+ * @brief Upsamples by 2^levels through g0 synthesis with zero details.
+ *
+ * The inverse of wavelet_decimate() for the band it keeps: it equals
+ * wavelet_reconstruct_blocked() of a pyramid whose detail bands are all
+ * zero, without reading or multiplying any detail coefficient.
+ *
+ * @param[in] approx The `length >> levels` approximation samples, where
+ *            levels is what wavelet_decimate() returns for `length`.
+ * @param[in] length The length of the upsampled signal.
+ * @param[in] config The configuration (wavelet and levels are used).
+ * @param[out] signal_out Buffer receiving `length` samples.
+ * @return The number of levels performed, or -1 on invalid arguments or
+ *         allocation failure.
+ */
+int wavelet_upsample(const int16_t* approx, uint32_t length, const wavelet_config_t* config, int16_t* signal_out);
+
+/**
+ * @brief Filters a signal of any length in overlapping blocks.
+ *
+ * The result is the wavelet_filter_inplace() output of the signal extended
+ * indefinitely on both sides, with the analysis grid anchored at sample 0,
+ * so it does not depend on the block or thread count. Each block is
+ * filtered in a window with `2^levels * (L + neighbourhood_radius)`
+ * samples of context on either side, of which only the block is kept.
+ * Windows are sized to half of the L2 cache unless a block length is
+ * given, and are spread across threads. Kernels of 48 taps or more (custom
+ * banks) run the long levels of each window as overlap-save FFT
+ * convolutions, with the same output.
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal.
+ * @param[in] config The filter configuration; all configured levels are
+ *            performed, whatever the signal length.
+ * @param[in] long_config The boundary extension, threads and block length.
+ * @param[out] signal_out Buffer receiving `length` samples; must not
+ *             overlap the input.
+ * @return 0 on success, -1 on invalid arguments, allocation failure, or
+ *         if the margins do not fit a 16-bit window.
+ */
+int wavelet_filter_long(const int16_t* signal, uint32_t length, const wavelet_config_t* config,
+                        const wavelet_long_config_t* long_config, int16_t* signal_out);
+
+/**
+ * @brief Lossless integer Haar decomposition (S-transform), using only adds and shifts.
+ *
+ * Uses the same sample pairing and Mallat layout as wavelet_decompose()
+ * with WAVELET_HAAR, but unnormalized: each pair (p0, p1) becomes the
+ * difference p1 - p0 and the average floor((p0 + p1) / 2). Differences
+ * need 17 bits, hence the int32_t pyramid. All levels are computed in one
+ * pass over blocks of 2^levels samples.
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal.
+ * @param[in] config Only decomposition_levels is used; it is reduced until
+ *            2^levels divides the length.
+ * @param[out] pyramid_out Buffer of `length` coefficients.
+ * @return The number of levels, or -1 on invalid arguments.
+ */
+int wavelet_haar_s_decompose(const int16_t* signal, uint16_t length, const wavelet_config_t* config, int32_t* pyramid_out);
+
+/**
+ * @brief Exact inverse of wavelet_haar_s_decompose().
+ *
+ * @param[in] pyramid The coefficient pyramid.
+ * @param[in] length The length of the original signal.
+ * @param[in] config The configuration used for the decomposition.
+ * @param[out] signal_out Buffer receiving `length` samples.
+ * @return The number of levels, or -1 on invalid arguments.
+ */
+int wavelet_haar_s_reconstruct(const int32_t* pyramid, uint16_t length, const wavelet_config_t* config, int16_t* signal_out);
+
+/**
+ * @brief Computes per-band features while decomposing a signal.
+ *
+ * The statistics are accumulated inside the analysis kernel as each detail
+ * coefficient is produced, so neither the pyramid nor a detail band is
+ * stored; only the approximations carried down the cascade. The features of cD_k start at
+ * `features_out[(k - 1) * WAVELET_FEATURES_PER_BAND]` and are indexed by
+ * wavelet_feature_t. Entries for levels that were not computed are zero.
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal.
+ * @param[in] config The configuration (wavelet and levels are used).
+ * @param[out] features_out Buffer of WAVELET_FEATURE_VECTOR_LENGTH floats.
+ * @return The effective number of levels, or -1 on invalid arguments.
+ */
+int wavelet_extract_features(const int16_t* signal, uint16_t length, const wavelet_config_t* config, float* features_out);
+
+/**
+ * @brief Computes feature vectors for several equally long channels.
+ *
+ * Channel c is read from `signals + c * length` and its features are written
+ * to `features_out + c * WAVELET_FEATURE_VECTOR_LENGTH`. Channels are
+ * decomposed WAVELET_BATCH_LANES at a time on the lane-parallel kernel used
+ * by wavelet_filter_batch(); the results match wavelet_extract_features().
+ *
+ * @param[in] signals Channel-major buffer of `channels * length` samples.
+ * @param[in] channels The number of channels.
+ * @param[in] length The length of each channel.
+ * @param[in] config The configuration shared by all channels.
+ * @param[out] features_out Buffer of `channels * WAVELET_FEATURE_VECTOR_LENGTH` floats.
+ * @return The effective number of levels, or -1 on invalid arguments.
+ */
+int wavelet_extract_features_batch(const int16_t* signals, uint16_t channels, uint16_t length, const wavelet_config_t* config, float* features_out);
+
 /**
  * @brief Main function to perform wavelet-based filtering based on a configuration.
  *
@@ -104,10 +774,485 @@ void apply_thresholding(int16_t* coeffs, uint16_t length, const wavelet_config_t
  * specified thresholding, and reconstructs the signal. The filtering is
  * done in-place.
  *
+ * With THRESHOLD_SPIKE and only a few outlier coefficients, the signal is
+ * not reconstructed; the synthesis contribution of each outlier is
+ * subtracted from the input directly, which costs O(outliers x footprint).
+ * The result matches the full path up to fixed-point rounding.
+ *
  * @param[in,out] signal Pointer to the signal buffer.
  * @param[in] length The length of the signal.
  * @param[in] config The configuration for the filtering process.
  */
 void wavelet_filter(int16_t* signal, uint16_t length, const wavelet_config_t* config);
 
+/**
+ * @brief Filters one signal with several threshold settings, decomposing once.
+ *
+ * The signal is decomposed with `config` a single time. For each of the
+ * `count` entries in `thresholds` the detail bands are thresholded with that
+ * entry's type and value and reconstructed into
+ * `outputs + i * length`. When both `reference` and `metrics_out` are given,
+ * the MSE and SNR of every output against `reference` are reported too.
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal.
+ * @param[in] config The base configuration (threshold fields and per-level
+ *                   thresholds are ignored).
+ * @param[in] thresholds Array of `count` threshold settings.
+ * @param[in] count The number of settings to evaluate.
+ * @param[out] outputs Buffer of `count * length` samples.
+ * @param[in] reference Optional reference signal of `length` samples, or NULL.
+ * @param[out] metrics_out Optional array of `count` metrics, or NULL.
+ * @return The effective number of levels, or -1 on invalid arguments.
+ */
+int wavelet_filter_sweep(const int16_t* signal, uint16_t length, const wavelet_config_t* config,
+                         const wavelet_threshold_t* thresholds, uint16_t count, int16_t* outputs,
+                         const int16_t* reference, wavelet_sweep_metrics_t* metrics_out);
+
+/**
+ * @brief Filters a signal and keeps the state needed for incremental edits.
+ *
+ * The filtered result is available in `state->output` and equals what
+ * wavelet_filter() would produce for the same signal and configuration.
+ *
+ * @param[out] state The incremental state to initialize.
+ * @param[in] signal Pointer to the input signal (copied into the state).
+ * @param[in] length The length of the signal.
+ * @param[in] config The configuration for the filtering process.
+ * @return The effective number of levels, or -1 on invalid arguments.
+ */
+int wavelet_incremental_init(wavelet_incremental_t* state, const int16_t* signal, uint16_t length, const wavelet_config_t* config);
+
+/**
+ * @brief Replaces samples [start, start + count) and refreshes the output.
+ *
+ * Only the coefficients whose kernels touch the edited samples are
+ * recomputed at each level, and only the output span they reach is
+ * re-synthesized, so the cost scales with the edit size and the kernel
+ * length rather than the signal length. The refreshed output span is
+ * reported in `state->dirty_start` / `state->dirty_count`.
+ *
+ * @param[in,out] state State from wavelet_incremental_init().
+ * @param[in] start Index of the first edited sample.
+ * @param[in] samples The `count` new sample values.
+ * @param[in] count The number of edited samples.
+ * @return 0 on success, or -1 on invalid arguments.
+ */
+int wavelet_incremental_update(wavelet_incremental_t* state, uint16_t start, const int16_t* samples, uint16_t count);
+
+/**
+ * @brief Locates spikes directly in the detail bands, without reconstruction.
+ *
+ * Each detail band cD_1 .. cD_n is scanned for local maxima of |cD| that
+ * reach `config->threshold_value`. Every peak is reported with the sample
+ * index its coefficient is centred on, its signed amplitude and its level.
+ * A spike usually shows up in several bands; each occurrence is reported.
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal.
+ * @param[in] config Wavelet, number of bands to scan and detection threshold.
+ * @param[out] events_out Array receiving up to `max_events` events.
+ * @param[in] max_events The capacity of `events_out`.
+ * @return The number of events written, or -1 on invalid arguments.
+ */
+int wavelet_detect_spikes(const int16_t* signal, uint16_t length, const wavelet_config_t* config,
+                          wavelet_spike_event_t* events_out, uint16_t max_events);
+
+/**
+ * @brief Initializes a streaming spike detector.
+ *
+ * @param[out] stream The detector state to initialize.
+ * @param[in] config Wavelet, number of bands to scan and detection threshold.
+ * @return 0 on success, or -1 on invalid arguments.
+ */
+int wavelet_spike_stream_init(wavelet_spike_stream_t* stream, const wavelet_config_t* config);
+
+/**
+ * @brief Feeds samples into a streaming spike detector.
+ *
+ * The stream runs the causal form of the analysis filters (the signal is
+ * treated as zero before the first sample), so a peak in cD_k is reported
+ * at most 2^(k+1) samples after its coefficient's last input arrives. Event
+ * indices are absolute sample positions since initialization.
+ *
+ * @param[in,out] stream The detector state.
+ * @param[in] samples The new samples.
+ * @param[in] count The number of new samples.
+ * @param[out] events_out Array receiving up to `max_events` events.
+ * @param[in] max_events The capacity of `events_out`.
+ * @return The number of events written, or -1 on invalid arguments.
+ */
+int wavelet_spike_stream_push(wavelet_spike_stream_t* stream, const int16_t* samples, uint16_t count,
+                              wavelet_spike_event_t* events_out, uint16_t max_events);
+
+/**
+ * @brief Initializes an adaptive threshold tracker.
+ *
+ * @param[out] tracker The tracker to initialize.
+ * @param[in] decay Per-coefficient forgetting factor in (0, 1), e.g. 0.999.
+ * @param[in] multiplier Threshold in units of the estimated noise sigma.
+ * @param[in] smoothing Fraction of the distance to the new target covered per update, in (0, 1].
+ * @param[in] initial_threshold Threshold reported before any update.
+ */
+void wavelet_tracker_init(wavelet_threshold_tracker_t* tracker, float decay, float multiplier,
+                          float smoothing, int16_t initial_threshold);
+
+/**
+ * @brief Folds new detail coefficients into the tracker and updates the threshold.
+ *
+ * @param[in,out] tracker The tracker.
+ * @param[in] coeffs The new detail coefficients.
+ * @param[in] count The number of coefficients.
+ */
+void wavelet_tracker_update(wavelet_threshold_tracker_t* tracker, const int16_t* coeffs, uint16_t count);
+
+/**
+ * @brief Returns the tracker's current threshold.
+ *
+ * @param[in] tracker The tracker.
+ * @return The threshold, rounded and clamped to int16_t.
+ */
+int16_t wavelet_tracker_threshold(const wavelet_threshold_tracker_t* tracker);
+
+/**
+ * @brief Initializes a streaming filter that processes fixed-size frames.
+ *
+ * @param[out] stream The stream state to initialize.
+ * @param[in] config The configuration for every frame.
+ * @param[in] frame_length The number of samples per frame.
+ * @return 0 on success, or -1 on invalid arguments.
+ */
+int wavelet_stream_init(wavelet_stream_t* stream, const wavelet_config_t* config, uint16_t frame_length);
+
+/**
+ * @brief Makes the stream track its threshold from the data.
+ *
+ * From then on every frame feeds its cD_1 coefficients to a
+ * wavelet_threshold_tracker_t and is filtered with the tracked threshold
+ * instead of the fixed `threshold_value`. With `per_level_thresholds` set,
+ * the tracked value replaces the `threshold_value` of every detail entry of
+ * `level_threshold`; their threshold types are kept.
+ *
+ * @param[in,out] stream The stream state.
+ * @param[in] decay See wavelet_tracker_init().
+ * @param[in] multiplier See wavelet_tracker_init().
+ * @param[in] smoothing See wavelet_tracker_init().
+ */
+void wavelet_stream_set_adaptive(wavelet_stream_t* stream, float decay, float multiplier, float smoothing);
+
+/**
+ * @brief Filters the next frame of a stream in place.
+ *
+ * @param[in,out] stream The stream state.
+ * @param[in,out] frame Buffer of `frame_length` samples.
+ * @return 0 on success, or -1 on failure.
+ */
+int wavelet_stream_process(wavelet_stream_t* stream, int16_t* frame);
+
+/**
+ * @brief Filters several equally long frames side by side.
+ *
+ * Frames are transposed into WAVELET_BATCH_LANES interleaved lanes so
+ * every kernel tap processes all lanes at once; a final partial group
+ * runs with zero lanes. Each frame ends up exactly as wavelet_filter()
+ * would leave it.
+ *
+ * @param[in,out] frames Pointers to `count` frames, filtered in place.
+ * @param[in] count The number of frames.
+ * @param[in] length The length of every frame (at most MAX_SIGNAL_LENGTH).
+ * @param[in] config The configuration shared by all frames.
+ * @return 0 on success, or -1 on invalid arguments or allocation failure.
+ */
+int wavelet_filter_batch(int16_t* const* frames, uint16_t count, uint16_t length, const wavelet_config_t* config);
+
+/**
+ * @brief Initializes a multi-stream aggregator.
+ *
+ * @param[out] aggregator The aggregator to initialize.
+ * @param[in] config The configuration shared by every stream.
+ * @param[in] frame_length The length of every frame.
+ * @param[in] max_delay_us The longest a frame may wait for a full batch.
+ * @param[in] deliver Called once per frame after it has been filtered.
+ * @param[in] user Passed through to `deliver`.
+ * @return 0 on success, or -1 on invalid arguments.
+ */
+int wavelet_aggregator_init(wavelet_aggregator_t* aggregator, const wavelet_config_t* config, uint16_t frame_length,
+                            uint64_t max_delay_us, wavelet_frame_callback_t deliver, void* user);
+
+/**
+ * @brief Queues a frame of one stream for filtering.
+ *
+ * The frame is filtered in place and handed to the callback, possibly
+ * during this call; the buffer must stay valid until then. A stream may
+ * have several frames pending, which are delivered in submission order.
+ *
+ * @param[in,out] aggregator The aggregator.
+ * @param[in] stream_id Caller-defined id passed back to the callback.
+ * @param[in,out] frame Buffer of `frame_length` samples.
+ * @param[in] now_us The current time on the caller's monotonic clock.
+ * @return The number of frames delivered during the call, or -1 on failure.
+ *         A batch that fails to filter is still delivered, with status -1.
+ */
+int wavelet_aggregator_submit(wavelet_aggregator_t* aggregator, uint32_t stream_id, int16_t* frame, uint64_t now_us);
+
+/**
+ * @brief Runs a partial batch if its oldest frame has reached the maximum delay.
+ *
+ * @param[in,out] aggregator The aggregator.
+ * @param[in] now_us The current time on the caller's monotonic clock.
+ * @return The number of frames delivered, or -1 on failure.
+ */
+int wavelet_aggregator_poll(wavelet_aggregator_t* aggregator, uint64_t now_us);
+
+/**
+ * @brief Runs whatever is pending immediately.
+ *
+ * The queue is empty afterwards: if filtering fails, the pending frames are
+ * delivered unfiltered with status -1.
+ *
+ * @param[in,out] aggregator The aggregator.
+ * @return The number of frames delivered, or -1 if the batch failed.
+ */
+int wavelet_aggregator_flush(wavelet_aggregator_t* aggregator);
+
+/**
+ * @brief Returns how long until the pending batch is due.
+ *
+ * @param[in] aggregator The aggregator.
+ * @param[in] now_us The current time on the caller's monotonic clock.
+ * @return Microseconds until wavelet_aggregator_poll() will run the batch
+ *         (0 if it is due), or UINT64_MAX if nothing is pending.
+ */
+uint64_t wavelet_aggregator_deadline(const wavelet_aggregator_t* aggregator, uint64_t now_us);
+
+/**
+ * @brief Initializes a single-producer/single-consumer sample ring.
+ *
+ * @param[out] ring The ring to initialize.
+ * @param[in] storage Caller-owned buffer of `capacity` samples.
+ * @param[in] capacity The ring size; must be a power of two.
+ * @param[in] publish_batch Samples written between index publications
+ *            (0 or 1 publishes on every push).
+ * @return 0 on success, or -1 on invalid arguments.
+ */
+int wavelet_ring_init(wavelet_ring_t* ring, int16_t* storage, uint32_t capacity, uint32_t publish_batch);
+
+/**
+ * @brief Appends samples without blocking (producer thread only).
+ *
+ * @param[in,out] ring The ring.
+ * @param[in] samples The samples to append.
+ * @param[in] count The number of samples.
+ * @return The number of samples accepted, less than `count` if the ring
+ *         is full. Accepted samples become visible to the consumer at the
+ *         next publication.
+ */
+uint32_t wavelet_ring_push(wavelet_ring_t* ring, const int16_t* samples, uint32_t count);
+
+/**
+ * @brief Makes every accepted sample visible to the consumer (producer thread only).
+ *
+ * @param[in,out] ring The ring.
+ */
+void wavelet_ring_publish(wavelet_ring_t* ring);
+
+/**
+ * @brief Returns the number of published samples waiting (consumer thread only).
+ *
+ * @param[in,out] ring The ring.
+ * @return The number of samples wavelet_ring_pop() can return right now.
+ */
+uint32_t wavelet_ring_available(wavelet_ring_t* ring);
+
+/**
+ * @brief Removes up to `max_count` published samples (consumer thread only).
+ *
+ * @param[in,out] ring The ring.
+ * @param[out] samples_out Buffer receiving the samples.
+ * @param[in] max_count The most samples to remove.
+ * @return The number of samples removed.
+ */
+uint32_t wavelet_ring_pop(wavelet_ring_t* ring, int16_t* samples_out, uint32_t max_count);
+
+/**
+ * @brief Filters the next frame of a stream fed through a ring.
+ *
+ * Takes exactly `frame_length` samples from the ring once that many are
+ * published, and filters them with wavelet_stream_process(). Call it from
+ * the ring's consumer thread.
+ *
+ * @param[in,out] stream The stream state.
+ * @param[in,out] ring The ring the acquisition thread pushes into.
+ * @param[out] frame Buffer of `frame_length` samples receiving the
+ *             filtered frame.
+ * @return 1 if a frame was filtered, 0 if not enough samples are
+ *         available yet, or -1 on failure.
+ */
+int wavelet_stream_consume(wavelet_stream_t* stream, wavelet_ring_t* ring, int16_t* frame);
+
+/**
+ * @brief Filters a whole input through a reader -> workers -> writer pipeline.
+ *
+ * A reader thread cuts the input into blocks, a pool of workers filters
+ * them, and the calling thread writes them back in input order. Each block
+ * is filtered with wavelet_filter_inplace() in a window with the margins
+ * of wavelet_filter_long(), so the output is that of wavelet_filter_long()
+ * over the whole stream, without seams at block edges. The stages exchange a fixed pool of buffers through
+ * bounded lock-free queues, so a slow stage throttles the others and no
+ * memory is allocated after start-up. Waiting stages spin briefly and
+ * then yield the CPU.
+ *
+ * @param[in] config The filter configuration for every block.
+ * @param[in] pipeline_config Block size, threads, buffers and I/O callbacks.
+ * @return 0 once all input has been written, or -1 on invalid arguments,
+ *         allocation or thread failure, or an I/O error.
+ */
+int wavelet_pipeline_run(const wavelet_config_t* config, const wavelet_pipeline_config_t* pipeline_config);
+
+/**
+ * @brief Starts a local filtering service shared by several processes (Linux).
+ *
+ * Requests travel through one shared-memory region (a memfd handed to each
+ * client over the Unix socket at `socket_path`, created with mode 0600):
+ * a table of request slots, a lock-free submission ring and a futex
+ * doorbell. A pool of warm worker threads filters each request in place
+ * in its slot. Idle workers spin briefly and then sleep on the doorbell.
+ * All clients share the region, so the service is meant for cooperating
+ * processes of one user.
+ *
+ * The service and client functions are only built when the library is
+ * compiled with WAVELET_WITH_SERVICE (make WITH_SERVICE=1, the default on
+ * Linux).
+ *
+ * @param[in] socket_path Path of the Unix socket to listen on; an existing
+ *            file at that path is replaced.
+ * @param[in] num_threads Worker threads (0 means 1).
+ * @return The service, or NULL if it could not be started.
+ */
+wavelet_service_t* wavelet_service_start(const char* socket_path, uint8_t num_threads);
+
+/**
+ * @brief Stops a service, removes its socket and frees it.
+ *
+ * Requests still in flight fail with -1 in their clients.
+ *
+ * @param[in] service The service to stop.
+ */
+void wavelet_service_stop(wavelet_service_t* service);
+
+/**
+ * @brief Counts the request slots currently held by clients.
+ *
+ * A client that exits or crashes with requests in flight has its slots
+ * reclaimed once the service sees its connection close.
+ *
+ * @param[in] service The service.
+ * @return The number of slots not free, or 0 if `service` is NULL.
+ */
+uint32_t wavelet_service_slots_in_use(const wavelet_service_t* service);
+
+/**
+ * @brief Connects to a running service and maps its request region.
+ *
+ * The connection stays open until wavelet_client_disconnect(), so that each
+ * side notices when the other goes away.
+ *
+ * @param[in] socket_path The path the service listens on.
+ * @return The client, or NULL if the service cannot be reached.
+ */
+wavelet_client_t* wavelet_client_connect(const char* socket_path);
+
+/**
+ * @brief Unmaps the request region, closes the connection and frees the client.
+ *
+ * @param[in] client The client to disconnect.
+ */
+void wavelet_client_disconnect(wavelet_client_t* client);
+
+/**
+ * @brief wavelet_filter() executed by the service.
+ *
+ * Copies the signal into a free slot, rings the doorbell and waits for a
+ * worker to filter it (spinning first, then sleeping on the slot's futex),
+ * then copies the result back. The result equals wavelet_filter().
+ * Configurations using wavelet_register_custom() handles are filtered
+ * locally, since registrations belong to the calling process. A client may
+ * be shared by several threads of one process.
+ *
+ * @param[in] client The connection to the service.
+ * @param[in,out] signal Pointer to the signal buffer.
+ * @param[in] length The length of the signal (at most MAX_SIGNAL_LENGTH).
+ * @param[in] config The configuration for the filtering process.
+ * @return 0 on success, or -1 on invalid arguments, if the service has
+ *         stopped or died, or if no answer came within
+ *         WAVELET_SERVICE_TIMEOUT_MS.
+ */
+int wavelet_client_filter(wavelet_client_t* client, int16_t* signal, uint16_t length, const wavelet_config_t* config);
+
+/**
+ * @brief Dual-tree complex wavelet decomposition.
+ *
+ * Runs two real DWTs with the configured wavelet side by side. Tree A is
+ * the ordinary DWT; tree B is offset by one sample at level 1 and uses the
+ * time-reversed filters below, so together they approximate an analytic
+ * wavelet with near shift-invariant magnitudes at 2x redundancy.
+ *
+ * The output has the Mallat layout of wavelet_decompose() with every
+ * coefficient replaced by an interleaved pair: coefficient k is the complex
+ * value `pyramid_out[2k] + i * pyramid_out[2k + 1]`.
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal.
+ * @param[in] config The configuration (wavelet and levels are used).
+ * @param[out] pyramid_out Buffer of `2 * length` values.
+ * @return The effective number of levels, or -1 on invalid arguments.
+ */
+int wavelet_dtcwt_decompose(const int16_t* signal, uint16_t length, const wavelet_config_t* config, int16_t* pyramid_out);
+
+/**
+ * @brief Inverts wavelet_dtcwt_decompose() by averaging both trees' reconstructions.
+ *
+ * @param[in] pyramid The interleaved pyramid of `2 * length` values.
+ * @param[in] length The length of the original signal.
+ * @param[in] config The configuration used for the decomposition.
+ * @param[out] signal_out Buffer receiving `length` reconstructed samples.
+ * @return The effective number of levels, or -1 on invalid arguments.
+ */
+int wavelet_dtcwt_reconstruct(const int16_t* pyramid, uint16_t length, const wavelet_config_t* config, int16_t* signal_out);
+
+/**
+ * @brief Filters a signal in place with the dual-tree transform.
+ *
+ * Band modes and thresholds act on the magnitude of each complex
+ * coefficient; both trees are then scaled by the same gain, so the phase
+ * is left unchanged. Every wavelet_band_mode_t and threshold_type_t is
+ * supported.
+ *
+ * @param[in,out] signal Pointer to the signal buffer.
+ * @param[in] length The length of the signal.
+ * @param[in] config The configuration for the filtering process.
+ */
+void wavelet_dtcwt_filter(int16_t* signal, uint16_t length, const wavelet_config_t* config);
+
+/**
+ * @brief Computes a continuous wavelet transform scalogram.
+ *
+ * The signal is transformed once; each scale then multiplies the spectrum
+ * by the daughter wavelet evaluated in the frequency domain and runs one
+ * inverse FFT. Daughters are energy-normalized as in Torrence and Compo,
+ * so magnitudes are comparable across scales. Power-of-two lengths are
+ * treated as periodic, like the DWT; other lengths are zero-padded to the
+ * next power of two.
+ *
+ * @param[in] signal Pointer to the input signal.
+ * @param[in] length The length of the signal.
+ * @param[in] scales The scales to evaluate, in samples (each > 0).
+ * @param[in] num_scales The number of scales.
+ * @param[in] config The mother wavelet and threading options.
+ * @param[out] scalogram_out Row-major `num_scales x length` matrix receiving |W(scale, t)|.
+ * @return 0 on success, or -1 on invalid arguments or allocation failure.
+ */
+int wavelet_cwt(const int16_t* signal, uint16_t length, const float* scales, uint16_t num_scales,
+                const wavelet_cwt_config_t* config, float* scalogram_out);
+
 #endif /* WAVELET_FILTER_H */
@@ -0,0 +1,189 @@
+/**
+ * @file wavelet_long.c
+ * @brief Overlapping-block filtering of signals of any length.
+ *
+ * A multi-level transform of an infinitely extended signal is local: with
+ * the analysis grid anchored at sample 0, output sample m only depends on
+ * the inputs within 2^levels * L samples of it, L being the kernel length.
+ * Each block is therefore filtered as one periodic window holding the
+ * block plus that margin on both sides, and only the block is kept; the
+ * wrapped edges of the window never reach it. Block starts and margins
+ * are multiples of 2^levels so every window sees the same grid.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "wavelet_filter.h"
+#include "wavelet_long.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define WAVELET_LONG_DEFAULT_L2 (256 * 1024) // Used when the cache size cannot be queried
+
+typedef struct {
+    const int16_t* signal;
+    uint32_t length;
+    const wavelet_config_t* config;
+    wavelet_extension_t extension;
+    int16_t* signal_out;
+    uint32_t block;   // Output samples per window
+    uint32_t margin;  // Context samples on each side
+    uint32_t window;  // margin + block + margin
+    uint32_t num_blocks;
+    uint32_t first_block;
+    uint32_t block_stride;
+    int status;
+} long_job_t;
+
+int64_t wavelet_long_extended_index(uint64_t length, wavelet_extension_t extension, int64_t p) {
+    if (p >= 0 && p < (int64_t)length) return p;
+    if (extension == WAVELET_EXTEND_ZERO || length == 0) return -1;
+
+    // Half-sample symmetric: x[-1 - i] = x[i] and x[N + i] = x[N - 1 - i],
+    // which repeats with period 2N.
+    int64_t period = 2 * (int64_t)length;
+    int64_t q = p % period;
+    if (q < 0) q += period;
+    if (q >= (int64_t)length) q = period - 1 - q;
+    return q;
+}
+
+// Sample p of the signal extended beyond [0, length).
+static int16_t extended_sample(const int16_t* signal, uint32_t length, wavelet_extension_t extension, int64_t p) {
+    int64_t q = wavelet_long_extended_index(length, extension, p);
+    return (q < 0) ? 0 : signal[q];
+}
+
+uint32_t wavelet_long_margin(const wavelet_config_t* config) {
+    if (!config) return 0;
+    uint8_t levels = config->decomposition_levels;
+    if (levels == 0 || levels > MAX_DECOMPOSITION_LEVELS) return 0;
+    uint8_t kernel_len = wavelet_kernel_length(config->wavelet);
+    if (kernel_len == 0) return 0;
+
+    uint32_t grid = 1u << levels;
+    uint32_t margin = grid * ((uint32_t)kernel_len + config->neighbourhood_radius);
+    return (2 * margin + grid > WAVELET_LONG_MAX_WINDOW) ? 0 : margin;
+}
+
+static void* long_worker(void* arg) {
+    long_job_t* job = (long_job_t*)arg;
+
+    int16_t* window = (int16_t*)malloc(job->window * sizeof(int16_t));
+    if (!window) {
+        job->status = -1;
+        return NULL;
+    }
+
+    for (uint32_t b = job->first_block; b < job->num_blocks; b += job->block_stride) {
+        uint32_t start = b * job->block;
+        int64_t origin = (int64_t)start - job->margin;
+        uint32_t count = job->length - start;
+        if (count > job->block) count = job->block;
+
+        // Copy the bulk of the window directly, extending only at the edges.
+        for (uint32_t t = 0; t < job->window; t++) {
+            int64_t p = origin + t;
+            if (p >= 0 && p + (int64_t)(job->window - t) <= (int64_t)job->length) {
+                memcpy(window + t, job->signal + p, (job->window - t) * sizeof(int16_t));
+                break;
+            }
+            window[t] = extended_sample(job->signal, job->length, job->extension, p);
+        }
+
+        wavelet_long_filter_window(window, (uint16_t)job->window, job->config);
+        memcpy(job->signal_out + start, window + job->margin, count * sizeof(int16_t));
+    }
+
+    free(window);
+    return NULL;
+}
+
+// Bytes of L2 cache per core, or WAVELET_LONG_DEFAULT_L2 if unknown.
+static long l2_cache_bytes(void) {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    long bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (bytes > 0) return bytes;
+#endif
+    return WAVELET_LONG_DEFAULT_L2;
+}
+
+int wavelet_filter_long(const int16_t* signal, uint32_t length, const wavelet_config_t* config,
+                        const wavelet_long_config_t* long_config, int16_t* signal_out) {
+    if (!signal || !config || !long_config || !signal_out || length == 0) return -1;
+    if (long_config->extension != WAVELET_EXTEND_ZERO && long_config->extension != WAVELET_EXTEND_SYMMETRIC) return -1;
+    uint32_t margin = wavelet_long_margin(config);
+    if (margin == 0) return -1;
+    uint8_t levels = config->decomposition_levels;
+    uint32_t grid = 1u << levels;
+
+    // The window and its output slice should stay in half of L2, leaving
+    // the rest for the kernels and the neighbouring core's traffic.
+    uint32_t block = long_config->block_length;
+    if (block == 0) {
+        long window_target = l2_cache_bytes() / 2 / (long)sizeof(int16_t);
+        if (window_target > WAVELET_LONG_MAX_WINDOW) window_target = WAVELET_LONG_MAX_WINDOW;
+        block = (window_target > (long)(2 * margin)) ? (uint32_t)window_target - 2 * margin : 0;
+    }
+    if (block > WAVELET_LONG_MAX_WINDOW - 2 * margin) block = WAVELET_LONG_MAX_WINDOW - 2 * margin;
+    block -= block % grid;
+    if (block < grid) block = grid;
+    // No point in windows wider than the signal needs.
+    uint32_t padded = length + (grid - length % grid) % grid;
+    if (block > padded) block = padded;
+
+    uint32_t window = block + 2 * margin;
+    if (wavelet_levels_for_length((uint16_t)window, config) != levels) return -1;
+
+    uint32_t num_blocks = (length + block - 1) / block;
+    uint32_t threads = long_config->num_threads;
+    if (threads < 1) threads = 1;
+    if (threads > num_blocks) threads = num_blocks;
+
+    long_job_t* jobs = (long_job_t*)malloc(threads * sizeof(long_job_t));
+    pthread_t* handles = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    uint8_t* started = (uint8_t*)calloc(threads, sizeof(uint8_t));
+    if (!jobs || !handles || !started) {
+        free(jobs);
+        free(handles);
+        free(started);
+        return -1;
+    }
+
+    // Blocks are dealt round-robin; job 0 runs on the caller's thread, as do
+    // jobs whose thread could not be started.
+    for (uint32_t i = 0; i < threads; i++) {
+        long_job_t* job = &jobs[i];
+        job->signal = signal;
+        job->length = length;
+        job->config = config;
+        job->extension = long_config->extension;
+        job->signal_out = signal_out;
+        job->block = block;
+        job->margin = margin;
+        job->window = window;
+        job->num_blocks = num_blocks;
+        job->first_block = i;
+        job->block_stride = threads;
+        job->status = 0;
+    }
+    for (uint32_t i = 1; i < threads; i++) {
+        started[i] = pthread_create(&handles[i], NULL, long_worker, &jobs[i]) == 0;
+    }
+    for (uint32_t i = 0; i < threads; i++) {
+        if (!started[i]) long_worker(&jobs[i]);
+    }
+
+    int status = 0;
+    for (uint32_t i = 0; i < threads; i++) {
+        if (started[i]) pthread_join(handles[i], NULL);
+        if (jobs[i].status != 0) status = -1;
+    }
+
+    free(jobs);
+    free(handles);
+    free(started);
+    return status;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file wavelet_long.h
+ * @brief Internal window geometry and window filter shared by the overlapping-block engines.
+ */
+
+#ifndef WAVELET_LONG_H
+#define WAVELET_LONG_H
+
+#include "wavelet_filter.h"
+
+/**
+ * @brief Longest window the in-place engine takes (16-bit lengths).
+ */
+#define WAVELET_LONG_MAX_WINDOW 65535
+
+/**
+ * @brief Context samples needed on either side of a block.
+ *
+ * The margin covers the analysis cone on the left, the synthesis cone on
+ * the right and the thresholding neighbourhood at every level, and is a
+ * multiple of 2^levels.
+ *
+ * @param[in] config The filter configuration.
+ * @return The margin, or 0 if the configuration is invalid or two margins
+ *         do not fit a 16-bit window.
+ */
+uint32_t wavelet_long_margin(const wavelet_config_t* config);
+
+/**
+ * @brief Maps a position of the extended signal back into the signal.
+ *
+ * @param[in] length The length of the signal.
+ * @param[in] extension The boundary extension.
+ * @param[in] p The position, possibly outside [0, length).
+ * @return The index in [0, length) holding sample p, or -1 where the
+ *         extension is zero.
+ */
+int64_t wavelet_long_extended_index(uint64_t length, wavelet_extension_t extension, int64_t p);
+
+/**
+ * @brief Filters one window of an overlapping-block engine in place.
+ *
+ * Same result as wavelet_filter_inplace(). Kernels of at least
+ * WAVELET_FFT_CROSSOVER taps on windows long enough for the FFT path are
+ * decomposed into a temporary pyramid instead, so that every long level
+ * runs as one overlap-save FFT convolution rather than direct loops.
+ *
+ * @param[in,out] window The window samples.
+ * @param[in] length The window length.
+ * @param[in] config The filter configuration.
+ */
+void wavelet_long_filter_window(int16_t* window, uint16_t length, const wavelet_config_t* config);
+
+#endif // WAVELET_LONG_H
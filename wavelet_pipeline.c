@@ -0,0 +1,352 @@
+/**
+ * @file wavelet_pipeline.c
+ * @brief Reader -> worker pool -> ordered writer pipeline for offline jobs.
+ *
+ * A fixed pool of block buffers circulates through three bounded lock-free
+ * MPMC queues: free -> filled (reader) -> done (workers) -> free (writer).
+ * The pool size is the only bound, so a slow stage stalls the ones before
+ * it (backpressure) and nothing is allocated once the pipeline is running.
+ * Workers finish out of order; the writer parks completed blocks in a
+ * reorder window indexed by sequence number modulo the pool size, which
+ * cannot collide because at most pool-size blocks are ever in flight.
+ *
+ * Blocks are not filtered as signals of their own. As in
+ * wavelet_filter_long(), every buffer holds one block plus a margin of
+ * context on either side; the reader carries the overlap from one window
+ * to the next and the writer keeps only the block, so the output is that
+ * of filtering the whole stream at once.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "wavelet_filter.h"
+#include "wavelet_long.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PIPELINE_SPINS 64             // Busy polls before yielding the CPU
+#define PIPELINE_END UINT32_MAX       // Queue value telling a worker to exit
+
+// Bounded MPMC queue of buffer indices (Vyukov's sequence-numbered ring):
+// a slot is free for the producer at position p when its sequence equals
+// p, and full for the consumer when it equals p + 1.
+typedef struct {
+    uint32_t sequence;
+    uint32_t value;
+} pipeline_slot_t;
+
+typedef struct {
+    pipeline_slot_t* slots;
+    uint32_t mask;
+    uint8_t pad0[WAVELET_CACHE_LINE];
+    uint32_t enqueue_pos;
+    uint8_t pad1[WAVELET_CACHE_LINE];
+    uint32_t dequeue_pos;
+    uint8_t pad2[WAVELET_CACHE_LINE];
+} pipeline_queue_t;
+
+typedef struct {
+    int16_t* samples;  // margin + block + margin
+    uint64_t sequence;
+    uint32_t length;   // Output samples of this block
+} pipeline_block_t;
+
+typedef struct {
+    const wavelet_config_t* config;
+    const wavelet_pipeline_config_t* pipeline;
+    pipeline_block_t* blocks;
+    uint32_t num_blocks;
+    uint32_t block;    // Output samples per window
+    uint32_t margin;   // Context samples on each side
+    uint32_t window;   // margin + block + margin
+    int16_t* carry;    // Raw input shared by consecutive windows (2 * margin)
+    pipeline_queue_t free_queue;
+    pipeline_queue_t filled_queue;
+    pipeline_queue_t done_queue;
+    uint32_t workers;
+    uint64_t total_blocks;  // Valid once input_done is set
+    int input_done;
+    int failed;
+} pipeline_t;
+
+static int queue_init(pipeline_queue_t* queue, uint32_t min_capacity) {
+    uint32_t capacity = 2;
+    while (capacity < min_capacity) capacity <<= 1;
+    memset(queue, 0, sizeof(*queue));
+    queue->slots = (pipeline_slot_t*)malloc(capacity * sizeof(pipeline_slot_t));
+    if (!queue->slots) return -1;
+    for (uint32_t i = 0; i < capacity; i++) queue->slots[i].sequence = i;
+    queue->mask = capacity - 1;
+    return 0;
+}
+
+static int queue_try_push(pipeline_queue_t* queue, uint32_t value) {
+    uint32_t pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        pipeline_slot_t* slot = &queue->slots[pos & queue->mask];
+        int32_t diff = (int32_t)(__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->enqueue_pos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                slot->value = value;
+                __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int queue_try_pop(pipeline_queue_t* queue, uint32_t* value) {
+    uint32_t pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        pipeline_slot_t* slot = &queue->slots[pos & queue->mask];
+        int32_t diff = (int32_t)(__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - (pos + 1));
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->dequeue_pos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *value = slot->value;
+                __atomic_store_n(&slot->sequence, pos + queue->mask + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int pipeline_failed(pipeline_t* pipeline) {
+    return __atomic_load_n(&pipeline->failed, __ATOMIC_ACQUIRE);
+}
+
+static void pipeline_fail(pipeline_t* pipeline) {
+    __atomic_store_n(&pipeline->failed, 1, __ATOMIC_RELEASE);
+}
+
+static void pipeline_backoff(uint32_t* spins) {
+    if (++*spins >= PIPELINE_SPINS) {
+        sched_yield();
+        *spins = 0;
+    }
+}
+
+// Blocking push/pop; they give up (returning 0) once the pipeline fails.
+static int queue_push(pipeline_t* pipeline, pipeline_queue_t* queue, uint32_t value) {
+    uint32_t spins = 0;
+    while (!queue_try_push(queue, value)) {
+        if (pipeline_failed(pipeline)) return 0;
+        pipeline_backoff(&spins);
+    }
+    return 1;
+}
+
+static int queue_pop(pipeline_t* pipeline, pipeline_queue_t* queue, uint32_t* value) {
+    uint32_t spins = 0;
+    while (!queue_try_pop(queue, value)) {
+        if (pipeline_failed(pipeline)) return 0;
+        pipeline_backoff(&spins);
+    }
+    return 1;
+}
+
+// Fills window positions [from, to) from the boundary extension of a
+// signal of `length` samples; the window starts at position `origin`. A
+// mirrored sample that has already left the window lies beyond the margin,
+// so it only has to be defined, not exact.
+static void pipeline_extend(int16_t* samples, int64_t origin, int64_t from, int64_t to,
+                            uint64_t length, wavelet_extension_t extension) {
+    for (int64_t p = from; p < to; p++) {
+        int64_t q = wavelet_long_extended_index(length, extension, p);
+        samples[p - origin] = (q < 0 || q < origin) ? 0 : samples[q - origin];
+    }
+}
+
+// Window t covers input positions [t * block - margin, t * block + block + margin).
+// Its first 2 * margin samples are the last 2 * margin of window t - 1,
+// which the reader saved in `carry` before handing that window on.
+static void* pipeline_reader(void* arg) {
+    pipeline_t* pipeline = (pipeline_t*)arg;
+    const wavelet_pipeline_config_t* io = pipeline->pipeline;
+    uint32_t overlap = 2 * pipeline->margin;
+    uint64_t read_pos = 0;  // Input samples read so far
+    int at_end = 0;
+    uint64_t sequence = 0;
+
+    for (;;) {
+        int64_t start = (int64_t)(sequence * pipeline->block);
+        if (at_end && (uint64_t)start >= read_pos) break;
+        int64_t origin = start - pipeline->margin;
+        int64_t end = origin + pipeline->window;
+
+        uint32_t index;
+        if (!queue_pop(pipeline, &pipeline->free_queue, &index)) return NULL;
+        pipeline_block_t* block = &pipeline->blocks[index];
+        int16_t* samples = block->samples;
+        if (sequence > 0) memcpy(samples, pipeline->carry, overlap * sizeof(int16_t));
+
+        // Read the rest of the window unless the input ends; short reads are fine.
+        while (!at_end && (int64_t)read_pos < end) {
+            int32_t got = io->read(io->read_io, samples + ((int64_t)read_pos - origin), (uint32_t)(end - (int64_t)read_pos));
+            if (got < 0) {
+                pipeline_fail(pipeline);
+                return NULL;
+            }
+            if (got == 0) at_end = 1;
+            read_pos += (uint32_t)got;
+        }
+        if (at_end && (uint64_t)start >= read_pos) {
+            queue_push(pipeline, &pipeline->free_queue, index);
+            break;
+        }
+
+        // Positions below 0 mirror samples that were already read; once the
+        // input has ended, so do positions past it.
+        pipeline_extend(samples, origin, origin, (end < 0) ? end : 0, read_pos, io->extension);
+        if (at_end) {
+            pipeline_extend(samples, origin, ((int64_t)read_pos > origin) ? (int64_t)read_pos : origin, end,
+                            read_pos, io->extension);
+        }
+
+        block->length = (at_end && read_pos - (uint64_t)start < pipeline->block) ? (uint32_t)(read_pos - (uint64_t)start) : pipeline->block;
+        block->sequence = sequence++;
+        memcpy(pipeline->carry, samples + pipeline->block, overlap * sizeof(int16_t));
+        if (!queue_push(pipeline, &pipeline->filled_queue, index)) return NULL;
+    }
+
+    pipeline->total_blocks = sequence;
+    __atomic_store_n(&pipeline->input_done, 1, __ATOMIC_RELEASE);
+    for (uint32_t w = 0; w < pipeline->workers; w++) {
+        if (!queue_push(pipeline, &pipeline->filled_queue, PIPELINE_END)) break;
+    }
+    return NULL;
+}
+
+static void* pipeline_worker(void* arg) {
+    pipeline_t* pipeline = (pipeline_t*)arg;
+    uint32_t index;
+    while (queue_pop(pipeline, &pipeline->filled_queue, &index) && index != PIPELINE_END) {
+        wavelet_filter_inplace(pipeline->blocks[index].samples, (uint16_t)pipeline->window, pipeline->config);
+        if (!queue_push(pipeline, &pipeline->done_queue, index)) break;
+    }
+    return NULL;
+}
+
+// Runs on the caller's thread: writes blocks in sequence order and hands
+// their buffers back to the reader.
+static void pipeline_writer(pipeline_t* pipeline, uint32_t* window) {
+    const wavelet_pipeline_config_t* io = pipeline->pipeline;
+    uint64_t next = 0;
+    uint32_t spins = 0;
+
+    for (;;) {
+        if (__atomic_load_n(&pipeline->input_done, __ATOMIC_ACQUIRE) && next == pipeline->total_blocks) return;
+
+        uint32_t index;
+        if (!queue_try_pop(&pipeline->done_queue, &index)) {
+            if (pipeline_failed(pipeline)) return;
+            pipeline_backoff(&spins);
+            continue;
+        }
+        spins = 0;
+        window[pipeline->blocks[index].sequence % pipeline->num_blocks] = index;
+
+        // Drain every block that is now in order.
+        for (;;) {
+            uint32_t ready = window[next % pipeline->num_blocks];
+            if (ready == PIPELINE_END || pipeline->blocks[ready].sequence != next) break;
+            window[next % pipeline->num_blocks] = PIPELINE_END;
+            pipeline_block_t* block = &pipeline->blocks[ready];
+            if (io->write(io->write_io, block->samples + pipeline->margin, block->length) != 0) {
+                pipeline_fail(pipeline);
+                return;
+            }
+            next++;
+            if (!queue_push(pipeline, &pipeline->free_queue, ready)) return;
+        }
+    }
+}
+
+// Starts the reader and workers, runs the writer and joins everything.
+static void pipeline_execute(pipeline_t* pipeline, uint32_t* window, pthread_t* threads, uint32_t workers) {
+    // Workers first, so the reader knows how many end markers to send.
+    uint32_t started = 0;
+    while (started < workers && pthread_create(&threads[started], NULL, pipeline_worker, pipeline) == 0) started++;
+    pipeline->workers = started;
+    int reader_started = started > 0 && pthread_create(&threads[started], NULL, pipeline_reader, pipeline) == 0;
+
+    if (reader_started) pipeline_writer(pipeline, window);
+    // A writer that stopped early must not leave the other stages waiting.
+    if (!reader_started || !__atomic_load_n(&pipeline->input_done, __ATOMIC_ACQUIRE)) pipeline_fail(pipeline);
+
+    if (reader_started) pthread_join(threads[started], NULL);
+    for (uint32_t w = 0; w < started; w++) pthread_join(threads[w], NULL);
+}
+
+int wavelet_pipeline_run(const wavelet_config_t* config, const wavelet_pipeline_config_t* pipeline_config) {
+    if (!config || !pipeline_config || !pipeline_config->read || !pipeline_config->write) return -1;
+    if (pipeline_config->extension != WAVELET_EXTEND_ZERO && pipeline_config->extension != WAVELET_EXTEND_SYMMETRIC) return -1;
+    if (pipeline_config->block_length == 0) return -1;
+
+    // Window geometry as in wavelet_filter_long().
+    uint32_t margin = wavelet_long_margin(config);
+    if (margin == 0) return -1;
+    uint32_t grid = 1u << config->decomposition_levels;
+    uint32_t block = pipeline_config->block_length;
+    if (block > WAVELET_LONG_MAX_WINDOW - 2 * margin) block = WAVELET_LONG_MAX_WINDOW - 2 * margin;
+    block -= block % grid;
+    if (block < grid) block = grid;
+    uint32_t window_length = block + 2 * margin;
+    if (wavelet_levels_for_length((uint16_t)window_length, config) != config->decomposition_levels) return -1;
+
+    uint32_t workers = (pipeline_config->num_workers > 0) ? pipeline_config->num_workers : 1;
+    uint32_t num_blocks = pipeline_config->num_buffers;
+    if (num_blocks == 0) num_blocks = 4 * workers;
+    if (num_blocks < 2) num_blocks = 2;
+
+    pipeline_t pipeline;
+    memset(&pipeline, 0, sizeof(pipeline));
+    pipeline.config = config;
+    pipeline.pipeline = pipeline_config;
+    pipeline.num_blocks = num_blocks;
+    pipeline.block = block;
+    pipeline.margin = margin;
+    pipeline.window = window_length;
+
+    // Everything is allocated up front; the filled queue has room for every
+    // buffer plus one end marker per worker, so pushes only ever wait on
+    // real backpressure.
+    pipeline.blocks = (pipeline_block_t*)calloc(num_blocks, sizeof(pipeline_block_t));
+    int16_t* storage = (int16_t*)malloc(((size_t)num_blocks * window_length + 2 * margin) * sizeof(int16_t));
+    uint32_t* window = (uint32_t*)malloc(num_blocks * sizeof(uint32_t));
+    pthread_t* threads = (pthread_t*)malloc((workers + 1) * sizeof(pthread_t));
+    int ready = pipeline.blocks && storage && window && threads &&
+                queue_init(&pipeline.free_queue, num_blocks) == 0 &&
+                queue_init(&pipeline.filled_queue, num_blocks + workers) == 0 &&
+                queue_init(&pipeline.done_queue, num_blocks) == 0;
+
+    int status = -1;
+    if (ready) {
+        pipeline.carry = storage + (size_t)num_blocks * window_length;
+        for (uint32_t i = 0; i < num_blocks; i++) {
+            pipeline.blocks[i].samples = storage + (size_t)i * window_length;
+            window[i] = PIPELINE_END;
+            queue_try_push(&pipeline.free_queue, i);
+        }
+        pipeline_execute(&pipeline, window, threads, workers);
+        status = pipeline_failed(&pipeline) ? -1 : 0;
+    }
+
+    free(pipeline.free_queue.slots);
+    free(pipeline.filled_queue.slots);
+    free(pipeline.done_queue.slots);
+    free(pipeline.blocks);
+    free(storage);
+    free(window);
+    free(threads);
+    return status;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file wavelet_ring.c
+ * @brief Lock-free single-producer/single-consumer ring for stream ingest.
+ *
+ * The producer copies samples in, then publishes its index with a release
+ * store; the consumer reads the index with an acquire load before copying
+ * the samples out, and releases its own index the same way. Each side
+ * re-reads the other's index only when its cached copy says the ring is
+ * full (producer) or empty (consumer), so in steady state the two threads
+ * exchange one cache line per publish batch.
+ */
+
+#include "wavelet_filter.h"
+#include <string.h>
+
+#define RING_LOAD_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RING_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+int wavelet_ring_init(wavelet_ring_t* ring, int16_t* storage, uint32_t capacity, uint32_t publish_batch) {
+    if (!ring || !storage || capacity < 2 || (capacity & (capacity - 1)) != 0) return -1;
+    memset(ring, 0, sizeof(*ring));
+    ring->buffer = storage;
+    ring->mask = capacity - 1;
+    ring->publish_batch = (publish_batch == 0) ? 1 : publish_batch;
+    return 0;
+}
+
+// Copies count samples starting at free-running index `index`, wrapping
+// at most once.
+static void ring_copy_in(wavelet_ring_t* ring, uint32_t index, const int16_t* samples, uint32_t count) {
+    uint32_t offset = index & ring->mask;
+    uint32_t first = ring->mask + 1 - offset;
+    if (first > count) first = count;
+    memcpy(ring->buffer + offset, samples, first * sizeof(int16_t));
+    memcpy(ring->buffer, samples + first, (count - first) * sizeof(int16_t));
+}
+
+static void ring_copy_out(const wavelet_ring_t* ring, uint32_t index, int16_t* samples, uint32_t count) {
+    uint32_t offset = index & ring->mask;
+    uint32_t first = ring->mask + 1 - offset;
+    if (first > count) first = count;
+    memcpy(samples, ring->buffer + offset, first * sizeof(int16_t));
+    memcpy(samples + first, ring->buffer, (count - first) * sizeof(int16_t));
+}
+
+uint32_t wavelet_ring_push(wavelet_ring_t* ring, const int16_t* samples, uint32_t count) {
+    uint32_t capacity = ring->mask + 1;
+    uint32_t space = capacity - (ring->write_index - ring->cached_tail);
+    if (space < count) {
+        ring->cached_tail = RING_LOAD_ACQUIRE(&ring->tail);
+        space = capacity - (ring->write_index - ring->cached_tail);
+    }
+    if (count > space) count = space;
+
+    if (count > 0) {
+        ring_copy_in(ring, ring->write_index, samples, count);
+        ring->write_index += count;
+    }
+
+    // Publish once a batch has accumulated, or when the ring is full and the
+    // consumer must see everything to make room.
+    uint32_t unpublished = ring->write_index - ring->head;
+    if (unpublished >= ring->publish_batch || ring->write_index - ring->cached_tail == capacity) {
+        RING_STORE_RELEASE(&ring->head, ring->write_index);
+    }
+    return count;
+}
+
+void wavelet_ring_publish(wavelet_ring_t* ring) {
+    RING_STORE_RELEASE(&ring->head, ring->write_index);
+}
+
+uint32_t wavelet_ring_available(wavelet_ring_t* ring) {
+    ring->cached_head = RING_LOAD_ACQUIRE(&ring->head);
+    return ring->cached_head - ring->tail;
+}
+
+uint32_t wavelet_ring_pop(wavelet_ring_t* ring, int16_t* samples_out, uint32_t max_count) {
+    uint32_t tail = ring->tail;
+    uint32_t available = ring->cached_head - tail;
+    if (available < max_count) {
+        ring->cached_head = RING_LOAD_ACQUIRE(&ring->head);
+        available = ring->cached_head - tail;
+    }
+    if (max_count > available) max_count = available;
+    if (max_count == 0) return 0;
+
+    ring_copy_out(ring, tail, samples_out, max_count);
+    RING_STORE_RELEASE(&ring->tail, tail + max_count);
+    return max_count;
+}
+
+int wavelet_stream_consume(wavelet_stream_t* stream, wavelet_ring_t* ring, int16_t* frame) {
+    if (!stream || !ring || !frame || stream->frame_length == 0) return -1;
+    if (ring->cached_head - ring->tail < stream->frame_length &&
+        wavelet_ring_available(ring) < stream->frame_length) {
+        return 0;
+    }
+    wavelet_ring_pop(ring, frame, stream->frame_length);
+    return (wavelet_stream_process(stream, frame) == 0) ? 1 : -1;
+}
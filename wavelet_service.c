@@ -0,0 +1,630 @@
+/**
+ * @file wavelet_service.c
+ * @brief Local shared-memory filtering service and its client library (Linux).
+ *
+ * The service owns one memfd region holding a table of request slots, a
+ * bounded lock-free submission ring of slot indices and a futex doorbell.
+ * A client connects once over a Unix socket, receives the memfd through
+ * SCM_RIGHTS and maps it; after that a request never touches the socket:
+ *
+ *   client: claim a FREE slot, copy samples and config in, mark it
+ *           SUBMITTED, push its index, ring the doorbell
+ *   worker: pop an index, filter the slot's samples in place, mark it DONE
+ *   client: wait for DONE, copy the samples out, release the slot
+ *
+ * Both sides spin briefly before sleeping on a futex, and only issue a
+ * FUTEX_WAKE when the other side has announced that it is asleep, so a
+ * busy service answers without any system call. All futexes are shared
+ * (not FUTEX_PRIVATE) because they live in memory mapped by several
+ * processes. Every client sees the whole region, so the service is meant
+ * for cooperating processes of one user; the socket is created 0600.
+ *
+ * The connection stays open for the client's lifetime and is how each side
+ * notices that the other has died. A sleeping client polls it for a hangup
+ * whenever its futex wait times out. The listener watches every connection;
+ * when one hangs up it reclaims the slots that client still held, which it
+ * can identify because each slot's futex word carries its owner's id.
+ */
+
+#define _GNU_SOURCE
+
+#include "wavelet_filter.h"
+#include <errno.h>
+#include <linux/futex.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SERVICE_MAGIC 0x57564c53u  // "WVLS"
+#define SERVICE_SPINS 2000         // Polls before sleeping on a futex
+#define SERVICE_MAX_THREADS 64
+#define SERVICE_SLEEP_NS 100000000 // Longest client sleep between liveness checks
+#define SERVICE_MAX_CLIENTS 256    // Connections the listener keeps open
+
+// A slot's futex word holds a SLOT_* state in the low byte, SLOT_SLEEPER
+// while its client waits on the futex, and the owning connection's id in
+// the upper bits. Every transition is a compare-and-swap of the whole word,
+// so a reclaim aimed at a dead client cannot hit a slot that has since been
+// freed and claimed by someone else. A free slot's word is 0.
+#define SLOT_STATE_MASK 0xffu
+#define SLOT_SLEEPER 0x100u
+#define SLOT_OWNER_SHIFT 9
+#define SLOT_OWNER_LIMIT (1u << (32 - SLOT_OWNER_SHIFT))
+
+enum {
+    SLOT_FREE,
+    SLOT_CLAIMED,
+    SLOT_SUBMITTED,
+    SLOT_SERVING,
+    SLOT_DONE,
+    SLOT_ORPHANED,         // Submitted, but the client is gone
+    SLOT_SERVING_ORPHANED  // Being filtered, but the client is gone
+};
+
+typedef struct {
+    uint32_t state;  // Futex word, see SLOT_STATE_MASK
+    int32_t status;
+    uint16_t length;
+    wavelet_config_t config;
+    int16_t samples[MAX_SIGNAL_LENGTH];
+    uint8_t pad[WAVELET_CACHE_LINE];
+} service_slot_t;
+
+typedef struct {
+    uint32_t sequence;
+    uint32_t value;
+} service_cell_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t shutdown;
+    uint8_t pad0[WAVELET_CACHE_LINE];
+    uint32_t doorbell;  // Futex word, bumped on every submission
+    uint32_t sleepers;  // Workers waiting on the doorbell
+    uint8_t pad1[WAVELET_CACHE_LINE];
+    uint32_t enqueue_pos;
+    uint8_t pad2[WAVELET_CACHE_LINE];
+    uint32_t dequeue_pos;
+    uint8_t pad3[WAVELET_CACHE_LINE];
+    service_cell_t ring[WAVELET_SERVICE_SLOTS];
+    service_slot_t slots[WAVELET_SERVICE_SLOTS];
+} service_region_t;
+
+struct wavelet_service {
+    service_region_t* region;
+    int memfd;
+    int listen_fd;
+    int stop_fd;  // eventfd that ends the listener
+    uint32_t next_owner;
+    char socket_path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+    pthread_t listener;
+    pthread_t workers[SERVICE_MAX_THREADS];
+    uint8_t num_workers;
+};
+
+struct wavelet_client {
+    service_region_t* region;
+    int connection;      // Hangs up when the service dies
+    uint32_t owner;      // This connection's id, already shifted into place
+    uint32_t next_slot;  // Where the next claim starts looking (a hint shared by the client's threads)
+};
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Sleeps while *word == expected, for at most `timeout` if it is non-NULL.
+static void futex_wait(uint32_t* word, uint32_t expected, const struct timespec* timeout) {
+    syscall(SYS_futex, word, FUTEX_WAIT, expected, timeout, NULL, 0);
+}
+
+static void futex_wake(uint32_t* word, int count) {
+    syscall(SYS_futex, word, FUTEX_WAKE, count, NULL, NULL, 0);
+}
+
+// The submission ring is the sequence-numbered MPMC queue also used by the
+// offline pipeline, here over shared memory. It holds one cell per slot,
+// so a claimed slot can be pushed at once; only the entries a reclaim
+// queues again can make a push wait briefly for a worker.
+static void ring_push(service_region_t* region, uint32_t value) {
+    uint32_t pos = __atomic_load_n(&region->enqueue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        service_cell_t* cell = &region->ring[pos % WAVELET_SERVICE_SLOTS];
+        int32_t diff = (int32_t)(__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&region->enqueue_pos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->value = value;
+                __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+                return;
+            }
+        } else if (diff < 0) {
+            // A popper has claimed the cell but not released it yet.
+            sched_yield();
+            pos = __atomic_load_n(&region->enqueue_pos, __ATOMIC_RELAXED);
+        } else {
+            pos = __atomic_load_n(&region->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int ring_try_pop(service_region_t* region, uint32_t* value) {
+    uint32_t pos = __atomic_load_n(&region->dequeue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        service_cell_t* cell = &region->ring[pos % WAVELET_SERVICE_SLOTS];
+        int32_t diff = (int32_t)(__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - (pos + 1));
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&region->dequeue_pos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *value = cell->value;
+                __atomic_store_n(&cell->sequence, pos + WAVELET_SERVICE_SLOTS, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = __atomic_load_n(&region->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// Moves the slot from `from` to `to`, keeping the owner and sleeper bits.
+// Fails if another state was seen first.
+static int slot_transition(service_slot_t* slot, uint32_t* word, uint32_t from, uint32_t to) {
+    if ((*word & SLOT_STATE_MASK) != from) return 0;
+    return __atomic_compare_exchange_n(&slot->state, word, (*word & ~SLOT_STATE_MASK) | to, 0, __ATOMIC_ACQ_REL,
+                                       __ATOMIC_ACQUIRE);
+}
+
+static void serve_slot(service_slot_t* slot) {
+    // Ring entries can be stale (a reclaim may push a slot again), so only
+    // a slot that is actually waiting for a worker is served.
+    uint32_t word = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+    for (;;) {
+        if (slot_transition(slot, &word, SLOT_SUBMITTED, SLOT_SERVING) ||
+            slot_transition(slot, &word, SLOT_ORPHANED, SLOT_SERVING_ORPHANED)) {
+            break;
+        }
+        uint32_t state = word & SLOT_STATE_MASK;
+        if (state != SLOT_SUBMITTED && state != SLOT_ORPHANED) return;
+    }
+
+    // The client may not touch a submitted slot, but it is still untrusted
+    // input: check the length before filtering.
+    wavelet_config_t config = slot->config;
+    uint16_t length = slot->length;
+    if (length == 0 || length > MAX_SIGNAL_LENGTH) {
+        slot->status = -1;
+    } else {
+        wavelet_filter(slot->samples, length, &config);
+        slot->status = 0;
+    }
+
+    // Hand the result to the client, or free the slot if the client is gone.
+    word = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t owner = word & ~(SLOT_STATE_MASK | SLOT_SLEEPER);
+        uint32_t next = ((word & SLOT_STATE_MASK) == SLOT_SERVING_ORPHANED) ? 0 : owner | SLOT_DONE;
+        if (__atomic_compare_exchange_n(&slot->state, &word, next, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) break;
+    }
+    if (word & SLOT_SLEEPER) futex_wake(&slot->state, 1);
+}
+
+// Gives up a slot on behalf of a client that will not come back for it:
+// an unsubmitted or finished slot is freed at once, one still waiting for
+// or inside a worker is freed by that worker. Returns 1 if the slot was
+// left waiting for a worker, which the caller may not have queued yet.
+static int orphan_slot(service_slot_t* slot, uint32_t owner) {
+    uint32_t word = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+    while ((word & ~(SLOT_STATE_MASK | SLOT_SLEEPER)) == owner) {
+        uint32_t next;
+        switch (word & SLOT_STATE_MASK) {
+            case SLOT_CLAIMED:
+            case SLOT_DONE:
+                next = 0;
+                break;
+            case SLOT_SUBMITTED:
+                next = owner | SLOT_ORPHANED;
+                break;
+            case SLOT_SERVING:
+                next = owner | SLOT_SERVING_ORPHANED;
+                break;
+            default:
+                return 0;
+        }
+        if (__atomic_compare_exchange_n(&slot->state, &word, next, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return (next & SLOT_STATE_MASK) == SLOT_ORPHANED;
+        }
+    }
+    return 0;
+}
+
+static void* service_worker(void* arg) {
+    service_region_t* region = ((wavelet_service_t*)arg)->region;
+    uint32_t spins = 0;
+
+    while (!__atomic_load_n(&region->shutdown, __ATOMIC_ACQUIRE)) {
+        uint32_t index;
+        if (ring_try_pop(region, &index)) {
+            if (index < WAVELET_SERVICE_SLOTS) serve_slot(&region->slots[index]);
+            spins = 0;
+            continue;
+        }
+        if (++spins < SERVICE_SPINS) continue;
+
+        // Announce the sleep, then re-check the ring against the doorbell
+        // value read afterwards so a submission in between is not missed.
+        __atomic_add_fetch(&region->sleepers, 1, __ATOMIC_SEQ_CST);
+        uint32_t bell = __atomic_load_n(&region->doorbell, __ATOMIC_SEQ_CST);
+        if (ring_try_pop(region, &index)) {
+            __atomic_sub_fetch(&region->sleepers, 1, __ATOMIC_SEQ_CST);
+            if (index < WAVELET_SERVICE_SLOTS) serve_slot(&region->slots[index]);
+        } else {
+            if (!__atomic_load_n(&region->shutdown, __ATOMIC_ACQUIRE)) futex_wait(&region->doorbell, bell, NULL);
+            __atomic_sub_fetch(&region->sleepers, 1, __ATOMIC_SEQ_CST);
+        }
+        spins = 0;
+    }
+    return NULL;
+}
+
+// Sends a new connection its owner id and the region's memfd.
+static int service_welcome(wavelet_service_t* service, int connection, uint32_t owner) {
+    struct iovec iov = { &owner, sizeof(owner) };
+    union {
+        struct cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(int))];
+    } control;
+    memset(&control, 0, sizeof(control));
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &service->memfd, sizeof(int));
+    return sendmsg(connection, &message, MSG_NOSIGNAL) == (ssize_t)sizeof(owner) ? 0 : -1;
+}
+
+// Frees every slot a departed client still held. Slots it had submitted
+// are queued again, since it may have died before queueing them.
+static void service_reclaim(service_region_t* region, uint32_t owner) {
+    for (uint32_t i = 0; i < WAVELET_SERVICE_SLOTS; i++) {
+        if (orphan_slot(&region->slots[i], owner)) {
+            ring_push(region, i);
+            __atomic_add_fetch(&region->doorbell, 1, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&region->sleepers, __ATOMIC_SEQ_CST) > 0) futex_wake(&region->doorbell, 1);
+        }
+    }
+}
+
+// Welcomes clients and keeps their connections open until they hang up,
+// then reclaims their slots. Closing the connections on the way out tells
+// the clients that the service has gone.
+static void* service_listener(void* arg) {
+    wavelet_service_t* service = (wavelet_service_t*)arg;
+    struct pollfd fds[2 + SERVICE_MAX_CLIENTS];
+    uint32_t owners[2 + SERVICE_MAX_CLIENTS];
+    nfds_t count = 2;
+    fds[0].fd = service->stop_fd;
+    fds[1].fd = service->listen_fd;
+
+    for (;;) {
+        for (nfds_t i = 0; i < count; i++) fds[i].events = POLLIN;
+        if (poll(fds, count, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[0].revents) break;
+
+        // Drop connections that hung up; a client never sends anything, so
+        // readable means end of file.
+        for (nfds_t i = 2; i < count;) {
+            if (!fds[i].revents) {
+                i++;
+                continue;
+            }
+            char byte;
+            if (recv(fds[i].fd, &byte, 1, MSG_DONTWAIT) > 0) {
+                i++;
+                continue;
+            }
+            close(fds[i].fd);
+            service_reclaim(service->region, owners[i]);
+            count--;
+            fds[i] = fds[count];
+            owners[i] = owners[count];
+        }
+
+        if (fds[1].revents & POLLIN) {
+            int connection = accept4(service->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+            if (connection < 0) continue;
+            if (count == 2 + SERVICE_MAX_CLIENTS) {
+                close(connection);  // The client sees the refusal as a failed connect
+                continue;
+            }
+            service->next_owner = (service->next_owner + 1) % SLOT_OWNER_LIMIT;
+            if (service->next_owner == 0) service->next_owner = 1;
+            uint32_t owner = service->next_owner << SLOT_OWNER_SHIFT;
+            if (service_welcome(service, connection, owner) != 0) {
+                close(connection);
+                continue;
+            }
+            fds[count].fd = connection;
+            owners[count] = owner;
+            count++;
+        }
+    }
+
+    for (nfds_t i = 2; i < count; i++) close(fds[i].fd);
+    return NULL;
+}
+
+static int socket_address(const char* path, struct sockaddr_un* address) {
+    if (!path || strlen(path) >= sizeof(address->sun_path)) return -1;
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    strcpy(address->sun_path, path);
+    return 0;
+}
+
+wavelet_service_t* wavelet_service_start(const char* socket_path, uint8_t num_threads) {
+    struct sockaddr_un address;
+    if (socket_address(socket_path, &address) != 0) return NULL;
+    if (num_threads == 0) num_threads = 1;
+    if (num_threads > SERVICE_MAX_THREADS) num_threads = SERVICE_MAX_THREADS;
+
+    wavelet_service_t* service = (wavelet_service_t*)calloc(1, sizeof(wavelet_service_t));
+    if (!service) return NULL;
+    service->listen_fd = -1;
+    strcpy(service->socket_path, socket_path);
+    service->stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (service->stop_fd < 0) {
+        free(service);
+        return NULL;
+    }
+
+    service->memfd = memfd_create("wavelet_service", MFD_CLOEXEC);
+    if (service->memfd < 0 || ftruncate(service->memfd, sizeof(service_region_t)) != 0) {
+        if (service->memfd >= 0) close(service->memfd);
+        close(service->stop_fd);
+        free(service);
+        return NULL;
+    }
+    void* mapping = mmap(NULL, sizeof(service_region_t), PROT_READ | PROT_WRITE, MAP_SHARED, service->memfd, 0);
+    if (mapping == MAP_FAILED) {
+        close(service->memfd);
+        close(service->stop_fd);
+        free(service);
+        return NULL;
+    }
+    service->region = (service_region_t*)mapping;
+    for (uint32_t i = 0; i < WAVELET_SERVICE_SLOTS; i++) service->region->ring[i].sequence = i;
+    service->region->magic = SERVICE_MAGIC;
+
+    // Only this user may connect; a stale socket from a previous run is replaced.
+    unlink(socket_path);
+    mode_t old_mask = umask(0077);
+    service->listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    int listening = service->listen_fd >= 0 &&
+                    bind(service->listen_fd, (struct sockaddr*)&address, sizeof(address)) == 0 &&
+                    listen(service->listen_fd, 16) == 0;
+    umask(old_mask);
+
+    int started = listening;
+    while (started && service->num_workers < num_threads) {
+        if (pthread_create(&service->workers[service->num_workers], NULL, service_worker, service) != 0) {
+            started = service->num_workers > 0;
+            break;
+        }
+        service->num_workers++;
+    }
+    if (started && pthread_create(&service->listener, NULL, service_listener, service) != 0) started = 0;
+
+    if (!started) {
+        __atomic_store_n(&service->region->shutdown, 1, __ATOMIC_RELEASE);
+        __atomic_add_fetch(&service->region->doorbell, 1, __ATOMIC_SEQ_CST);
+        futex_wake(&service->region->doorbell, INT32_MAX);
+        for (uint8_t w = 0; w < service->num_workers; w++) pthread_join(service->workers[w], NULL);
+        if (service->listen_fd >= 0) close(service->listen_fd);
+        if (listening) unlink(socket_path);
+        munmap(service->region, sizeof(service_region_t));
+        close(service->memfd);
+        close(service->stop_fd);
+        free(service);
+        return NULL;
+    }
+    return service;
+}
+
+void wavelet_service_stop(wavelet_service_t* service) {
+    if (!service) return;
+
+    uint64_t one = 1;
+    if (write(service->stop_fd, &one, sizeof(one)) != (ssize_t)sizeof(one)) shutdown(service->listen_fd, SHUT_RDWR);
+    pthread_join(service->listener, NULL);
+    close(service->listen_fd);
+    close(service->stop_fd);
+    unlink(service->socket_path);
+
+    __atomic_store_n(&service->region->shutdown, 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&service->region->doorbell, 1, __ATOMIC_SEQ_CST);
+    futex_wake(&service->region->doorbell, INT32_MAX);
+    for (uint8_t w = 0; w < service->num_workers; w++) pthread_join(service->workers[w], NULL);
+
+    // Connected clients keep their own mapping; they see the shutdown flag
+    // (or their closed connection) once woken, and abandon any request
+    // still in flight.
+    for (uint32_t i = 0; i < WAVELET_SERVICE_SLOTS; i++) futex_wake(&service->region->slots[i].state, INT32_MAX);
+    munmap(service->region, sizeof(service_region_t));
+    close(service->memfd);
+    free(service);
+}
+
+wavelet_client_t* wavelet_client_connect(const char* socket_path) {
+    struct sockaddr_un address;
+    if (socket_address(socket_path, &address) != 0) return NULL;
+
+    int connection = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (connection < 0) return NULL;
+    if (connect(connection, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(connection);
+        return NULL;
+    }
+
+    uint32_t owner = 0;
+    struct iovec iov = { &owner, sizeof(owner) };
+    union {
+        struct cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(int))];
+    } control;
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+    ssize_t received = recvmsg(connection, &message, MSG_CMSG_CLOEXEC | MSG_WAITALL);
+
+    struct cmsghdr* cmsg = (received == (ssize_t)sizeof(owner)) ? CMSG_FIRSTHDR(&message) : NULL;
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+        cmsg->cmsg_len != CMSG_LEN(sizeof(int)) || owner == 0) {
+        close(connection);
+        return NULL;
+    }
+    int memfd;
+    memcpy(&memfd, CMSG_DATA(cmsg), sizeof(int));
+
+    struct stat info;
+    void* mapping = MAP_FAILED;
+    if (fstat(memfd, &info) == 0 && (size_t)info.st_size >= sizeof(service_region_t)) {
+        mapping = mmap(NULL, sizeof(service_region_t), PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    }
+    close(memfd);
+    if (mapping == MAP_FAILED) {
+        close(connection);
+        return NULL;
+    }
+
+    wavelet_client_t* client = (wavelet_client_t*)calloc(1, sizeof(wavelet_client_t));
+    if (!client || ((service_region_t*)mapping)->magic != SERVICE_MAGIC) {
+        free(client);
+        munmap(mapping, sizeof(service_region_t));
+        close(connection);
+        return NULL;
+    }
+    client->region = (service_region_t*)mapping;
+    client->connection = connection;
+    client->owner = owner;
+    return client;
+}
+
+void wavelet_client_disconnect(wavelet_client_t* client) {
+    if (!client) return;
+    munmap(client->region, sizeof(service_region_t));
+    close(client->connection);
+    free(client);
+}
+
+// The service never writes after the handshake, so a readable connection
+// means it has closed: the service stopped or its process died.
+static int service_gone(const wavelet_client_t* client) {
+    if (__atomic_load_n(&client->region->shutdown, __ATOMIC_ACQUIRE)) return 1;
+    struct pollfd connection = { client->connection, POLLIN, 0 };
+    return poll(&connection, 1, 0) != 0;
+}
+
+int wavelet_client_filter(wavelet_client_t* client, int16_t* signal, uint16_t length, const wavelet_config_t* config) {
+    if (!client || !signal || !config || length == 0 || length > MAX_SIGNAL_LENGTH) return -1;
+    service_region_t* region = client->region;
+
+    // Custom filter banks are registered per process, so the service
+    // cannot know them; filter those locally.
+    if (config->wavelet >= WAVELET_CUSTOM_FIRST) {
+        wavelet_filter(signal, length, config);
+        return 0;
+    }
+
+    // Claim a free slot, starting after the last one this client used.
+    uint64_t deadline = monotonic_ns() + (uint64_t)WAVELET_SERVICE_TIMEOUT_MS * 1000000u;
+    service_slot_t* slot = NULL;
+    uint32_t index = __atomic_load_n(&client->next_slot, __ATOMIC_RELAXED);
+    uint32_t spins = 0;
+    while (!slot) {
+        if (__atomic_load_n(&region->shutdown, __ATOMIC_ACQUIRE)) return -1;
+        uint32_t expected = 0;
+        if (__atomic_compare_exchange_n(&region->slots[index].state, &expected, client->owner | SLOT_CLAIMED, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            slot = &region->slots[index];
+            break;
+        }
+        index = (index + 1) % WAVELET_SERVICE_SLOTS;
+        if (++spins % WAVELET_SERVICE_SLOTS == 0) {
+            sched_yield();
+            if (service_gone(client) || monotonic_ns() > deadline) return -1;
+        }
+    }
+    __atomic_store_n(&client->next_slot, (index + 1) % WAVELET_SERVICE_SLOTS, __ATOMIC_RELAXED);
+
+    slot->config = *config;
+    slot->length = length;
+    memcpy(slot->samples, signal, length * sizeof(int16_t));
+    __atomic_store_n(&slot->state, client->owner | SLOT_SUBMITTED, __ATOMIC_RELEASE);
+    ring_push(region, index);
+
+    __atomic_add_fetch(&region->doorbell, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&region->sleepers, __ATOMIC_SEQ_CST) > 0) futex_wake(&region->doorbell, 1);
+
+    // Spin for a fast answer, then sleep until the worker wakes us. Each
+    // time a sleep ends without an answer, check that the service is still
+    // there and that the request has not run out of time.
+    spins = 0;
+    int slept = 0;
+    for (;;) {
+        uint32_t word = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+        if ((word & SLOT_STATE_MASK) == SLOT_DONE) break;
+        if (__atomic_load_n(&region->shutdown, __ATOMIC_ACQUIRE)) return -1;  // Slot is abandoned with the service
+        if (++spins < SERVICE_SPINS) continue;
+        if (slept && service_gone(client)) return -1;
+        if (slept && monotonic_ns() > deadline) {
+            orphan_slot(slot, client->owner);  // A worker still holding it frees it when done
+            return -1;
+        }
+        if (!(word & SLOT_SLEEPER) &&
+            !__atomic_compare_exchange_n(&slot->state, &word, word | SLOT_SLEEPER, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            continue;  // Moved on meanwhile
+        }
+        struct timespec timeout = { 0, SERVICE_SLEEP_NS };
+        futex_wait(&slot->state, word | SLOT_SLEEPER, &timeout);
+        slept = 1;
+    }
+
+    int status = slot->status;
+    if (status == 0) memcpy(signal, slot->samples, length * sizeof(int16_t));
+    __atomic_store_n(&slot->state, 0, __ATOMIC_RELEASE);
+    return status;
+}
+
+uint32_t wavelet_service_slots_in_use(const wavelet_service_t* service) {
+    if (!service) return 0;
+    uint32_t in_use = 0;
+    for (uint32_t i = 0; i < WAVELET_SERVICE_SLOTS; i++) {
+        in_use += __atomic_load_n(&service->region->slots[i].state, __ATOMIC_ACQUIRE) != 0;
+    }
+    return in_use;
+}
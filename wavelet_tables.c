@@ -0,0 +1,922 @@
+/**
+ * @file wavelet_tables.c
+ * @brief Q14 filter banks for the Daubechies, Symlet and Coiflet families.
+ *
+ * Generated by tools/gen_wavelet_tables.py; do not edit by hand. Each bank
+ * follows the same relations as the hand-written tables in wavelet_filter.c:
+ * h1 is the quadrature mirror of h0 and g0/g1 are their time reverses.
+ */
+
+#include "wavelet_tables.h"
+
+// db2 (L=4)
+static const int16_t db2_h0[] = {
+    7913, 13705, 3672, -2120
+};
+static const int16_t db2_h1[] = {
+    -2120, -3672, 13705, -7913
+};
+static const int16_t db2_g0[] = {
+    -2120, 3672, 13705, 7913
+};
+static const int16_t db2_g1[] = {
+    -7913, 13705, -3672, -2120
+};
+
+// db3 (L=6)
+static const int16_t db3_h0[] = {
+    5450, 13220, 7535, -2212, -1400, 577
+};
+static const int16_t db3_h1[] = {
+    577, 1400, -2212, -7535, 13220, -5450
+};
+static const int16_t db3_g0[] = {
+    577, -1400, -2212, 7535, 13220, 5450
+};
+static const int16_t db3_g1[] = {
+    -5450, 13220, -7535, -2212, 1400, 577
+};
+
+// db4 (L=8)
+static const int16_t db4_h0[] = {
+    3775, 11711, 10336, -458, -3064, 505, 539, -174
+};
+static const int16_t db4_h1[] = {
+    -174, -539, 505, 3064, -458, -10336, 11711, -3775
+};
+static const int16_t db4_g0[] = {
+    -174, 539, 505, -3064, -458, 10336, 11711, 3775
+};
+static const int16_t db4_g1[] = {
+    -3775, 11711, -10336, -458, 3064, 505, -539, -174
+};
+
+// db5 (L=10)
+static const int16_t db5_h0[] = {
+    2623, 9893, 11866, 2268, -3970, -528, 1271, -102, -206, 55
+};
+static const int16_t db5_h1[] = {
+    55, 206, -102, -1271, -528, 3970, 2268, -11866, 9893, -2623
+};
+static const int16_t db5_g0[] = {
+    55, -206, -102, 1271, -528, -3970, 2268, 11866, 9893, 2623
+};
+static const int16_t db5_g1[] = {
+    -2623, 9893, -11866, 2268, 3970, -528, -1271, -102, 206, 55
+};
+
+// db6 (L=12)
+static const int16_t db6_h0[] = {
+    1827, 8104, 12307, 5165, -3707, -2126, 1597, 451, -517, 9,
+    78, -18
+};
+static const int16_t db6_h1[] = {
+    -18, -78, 9, 517, 451, -1597, -2126, 3707, 5165, -12307,
+    8104, -1827
+};
+static const int16_t db6_g0[] = {
+    -18, 78, 9, -517, 451, 1597, -2126, -3707, 5165, 12307,
+    8104, 1827
+};
+static const int16_t db6_g1[] = {
+    -1827, 8104, -12307, 5165, 3707, -2126, -1597, 451, 517, 9,
+    -78, -18
+};
+
+// db7 (L=14)
+static const int16_t db7_h0[] = {
+    1276, 6497, 11946, 7697, -2358, -3671, 1168, 1321, -623, -272,
+    206, 7, -30, 6
+};
+static const int16_t db7_h1[] = {
+    6, 30, 7, -206, -272, 623, 1321, -1168, -3671, 2358,
+    7697, -11946, 6497, -1276
+};
+static const int16_t db7_g0[] = {
+    6, -30, 7, 206, -272, -623, 1321, 1168, -3671, -2358,
+    7697, 11946, 6497, 1276
+};
+static const int16_t db7_g1[] = {
+    -1276, 6497, -11946, 7697, 2358, -3671, -1168, 1321, 623, -272,
+    -206, 7, 30, 6
+};
+
+// db8 (L=16)
+static const int16_t db8_h0[] = {
+    892, 5126, 11069, 9590, -259, -4653, 8, 2109, -285, -722,
+    229, 143, -80, -6, 11, -2
+};
+static const int16_t db8_h1[] = {
+    -2, -11, -6, 80, 143, -229, -722, 285, 2109, -8,
+    -4653, 259, 9590, -11069, 5126, -892
+};
+static const int16_t db8_g0[] = {
+    -2, 11, -6, -80, 143, 229, -722, -285, 2109, 8,
+    -4653, -259, 9590, 11069, 5126, 892
+};
+static const int16_t db8_g1[] = {
+    -892, 5126, -11069, 9590, 259, -4653, -8, 2109, 285, -722,
+    -229, 143, 80, -6, -11, -2
+};
+
+// db9 (L=18)
+static const int16_t db9_h0[] = {
+    624, 3995, 9909, 10769, 2182, -4805, -1587, 2434, 503, -1108,
+    4, 366, -77, -70, 30, 4, -4, 1
+};
+static const int16_t db9_h1[] = {
+    1, 4, 4, -30, -70, 77, 366, -4, -1108, -503,
+    2434, 1587, -4805, -2182, 10769, -9909, 3995, -624
+};
+static const int16_t db9_g0[] = {
+    1, -4, 4, 30, -70, -77, 366, 4, -1108, 503,
+    2434, -1587, -4805, 2182, 10769, 9909, 3995, 624
+};
+static const int16_t db9_g1[] = {
+    -624, 3995, -9909, 10769, -2182, -4805, 1587, 2434, -503, -1108,
+    -4, 366, 77, -70, -30, 4, 4, 1
+};
+
+// db10 (L=20)
+static const int16_t db10_h0[] = {
+    437, 3083, 8638, 11277, 4607, -4093, -3210, 2087, 1525, -1170,
+    -483, 544, 59, -176, 23, 33, -11, -2, 2, 0
+};
+static const int16_t db10_h1[] = {
+    0, -2, -2, 11, 33, -23, -176, -59, 544, 483,
+    -1170, -1525, 2087, 3210, -4093, -4607, 11277, -8638, 3083, -437
+};
+static const int16_t db10_g0[] = {
+    0, 2, -2, -11, 33, 23, -176, 59, 544, -483,
+    -1170, 1525, 2087, -3210, -4093, 4607, 11277, 8638, 3083, 437
+};
+static const int16_t db10_g1[] = {
+    -437, 3083, -8638, 11277, -4607, -4093, 3210, 2087, -1525, -1170,
+    483, 544, -59, -176, -23, 33, 11, -2, -2, 0
+};
+
+// db11 (L=22)
+static const int16_t db11_h0[] = {
+    306, 2360, 7371, 11237, 6750, -2659, -4493, 1082, 2455, -762,
+    -1089, 513, 341, -252, -55, 81, -5, -15, 4, 1,
+    -1, 0
+};
+static const int16_t db11_h1[] = {
+    0, 1, 1, -4, -15, 5, 81, 55, -252, -341,
+    513, 1089, -762, -2455, 1082, 4493, -2659, -6750, 11237, -7371,
+    2360, -306
+};
+static const int16_t db11_g0[] = {
+    0, -1, 1, 4, -15, -5, 81, -55, -252, 341,
+    513, -1089, -762, 2455, 1082, -4493, -2659, 6750, 11237, 7371,
+    2360, 306
+};
+static const int16_t db11_g1[] = {
+    -306, 2360, -7371, 11237, -6750, -2659, 4493, 1082, -2455, -762,
+    1089, 513, -341, -252, 55, 81, 5, -15, -4, 1,
+    1, 0
+};
+
+// db12 (L=24)
+static const int16_t db12_h0[] = {
+    215, 1795, 6183, 10765, 8452, -733, -5180, -390, 2990, 88,
+    -1580, 178, 681, -200, -210, 110, 37, -36, 0, 6,
+    -1, 0, 0, 0
+};
+static const int16_t db12_h1[] = {
+    0, 0, 0, 1, 6, 0, -36, -37, 110, 210,
+    -200, -681, 178, 1580, 88, -2990, -390, 5180, -733, -8452,
+    10765, -6183, 1795, -215
+};
+static const int16_t db12_g0[] = {
+    0, 0, 0, -1, 6, 0, -36, 37, 110, -210,
+    -200, 681, 178, -1580, 88, 2990, -390, -5180, -733, 8452,
+    10765, 6183, 1795, 215
+};
+static const int16_t db12_g1[] = {
+    -215, 1795, -6183, 10765, -8452, -733, 5180, -390, -2990, 88,
+    1580, 178, -681, -200, 210, 110, -37, -36, 0, 6,
+    1, 0, 0, 0
+};
+
+// db13 (L=26)
+static const int16_t db13_h0[] = {
+    151, 1358, 5112, 10011, 9648, 1425, -5161, -2041, 2941, 1195,
+    -1734, -434, 920, 39, -390, 64, 119, -45, -22, 15,
+    1, -3, 1, 0, 0, 0
+};
+static const int16_t db13_h1[] = {
+    0, 0, 0, -1, -3, -1, 15, 22, -45, -119,
+    64, 390, 39, -920, -434, 1734, 1195, -2941, -2041, 5161,
+    1425, -9648, 10011, -5112, 1358, -151
+};
+static const int16_t db13_g0[] = {
+    0, 0, 0, 1, -3, 1, 15, -22, -45, 119,
+    64, -390, 39, 920, -434, -1734, 1195, 2941, -2041, -5161,
+    1425, 9648, 10011, 5112, 1358, 151
+};
+static const int16_t db13_g1[] = {
+    -151, 1358, -5112, 10011, -9648, 1425, 5161, -2041, -2941, 1195,
+    1734, -434, -920, 39, 390, 64, -119, -45, 22, 15,
+    -1, -3, -1, 0, 0, 0
+};
+
+// db14 (L=28)
+static const int16_t db14_h0[] = {
+    106, 1022, 4175, 9082, 10339, 3583, -4451, -3572, 2267, 2294,
+    -1421, -1172, 905, 442, -495, -92, 210, -12, -63, 17,
+    12, -6, -1, 1, 0, 0, 0, 0
+};
+static const int16_t db14_h1[] = {
+    0, 0, 0, 0, 1, 1, -6, -12, 17, 63,
+    -12, -210, -92, 495, 442, -905, -1172, 1421, 2294, -2267,
+    -3572, 4451, 3583, -10339, 9082, -4175, 1022, -106
+};
+static const int16_t db14_g0[] = {
+    0, 0, 0, 0, 1, -1, -6, 12, 17, -63,
+    -12, 210, -92, -495, 442, 905, -1172, -1421, 2294, 2267,
+    -3572, -4451, 3583, 10339, 9082, 4175, 1022, 106
+};
+static const int16_t db14_g1[] = {
+    -106, 1022, -4175, 9082, -10339, 3583, 4451, -3572, -2267, 2294,
+    1421, -1172, -905, 442, 495, -92, -210, -12, 63, 17,
+    -12, -6, 1, 1, 0, 0, 0, 0
+};
+
+// db15 (L=30)
+static const int16_t db15_h0[] = {
+    74, 766, 3375, 8071, 10580, 5554, -3165, -4733, 1070, 3115,
+    -650, -1821, 555, 898, -422, -341, 247, 84, -106, -4,
+    32, -6, -6, 3, 0, 0, 0, 0, 0, 0
+};
+static const int16_t db15_h1[] = {
+    0, 0, 0, 0, 0, 0, 3, 6, -6, -32,
+    -4, 106, 84, -247, -341, 422, 898, -555, -1821, 650,
+    3115, -1070, -4733, 3165, 5554, -10580, 8071, -3375, 766, -74
+};
+static const int16_t db15_g0[] = {
+    0, 0, 0, 0, 0, 0, 3, -6, -6, 32,
+    -4, -106, 84, 247, -341, -422, 898, 555, -1821, -650,
+    3115, 1070, -4733, -3165, 5554, 10580, 8071, 3375, 766, 74
+};
+static const int16_t db15_g1[] = {
+    -74, 766, -3375, 8071, -10580, 5554, 3165, -4733, -1070, 3115,
+    650, -1821, -555, 898, 422, -341, -247, 84, 106, -4,
+    -32, -6, 6, 3, 0, 0, 0, 0, 0, 0
+};
+
+// db16 (L=32)
+static const int16_t db16_h0[] = {
+    52, 572, 2704, 7050, 10441, 7214, -1470, -5359, -457, 3460,
+    448, -2169, -102, 1244, -124, -604, 169, 229, -115, -60,
+    51, 7, -15, 2, 3, -1, 0, 0, 0, 0,
+    0, 0
+};
+static const int16_t db16_h1[] = {
+    0, 0, 0, 0, 0, 0, -1, -3, 2, 15,
+    7, -51, -60, 115, 229, -169, -604, 124, 1244, 102,
+    -2169, -448, 3460, 457, -5359, 1470, 7214, -10441, 7050, -2704,
+    572, -52
+};
+static const int16_t db16_g0[] = {
+    0, 0, 0, 0, 0, 0, -1, 3, 2, -15,
+    7, 51, -60, -115, 229, 169, -604, -124, 1244, -102,
+    -2169, 448, 3460, -457, -5359, -1470, 7214, 10441, 7050, 2704,
+    572, 52
+};
+static const int16_t db16_g1[] = {
+    -52, 572, -2704, 7050, -10441, 7214, 1470, -5359, 457, 3460,
+    -448, -2169, 102, 1244, 124, -604, -169, 229, 115, -60,
+    -51, 7, 15, 2, -3, -1, 0, 0, 0, 0,
+    0, 0
+};
+
+// db17 (L=34)
+static const int16_t db17_h0[] = {
+    37, 426, 2150, 6068, 10008, 8492, 448, -5379, -2074, 3233,
+    1657, -2078, -935, 1329, 366, -769, -54, 372, -50, -141,
+    49, 38, -24, -5, 7, 0, -1, 0, 0, 0,
+    0, 0, 0, 0
+};
+static const int16_t db17_h1[] = {
+    0, 0, 0, 0, 0, 0, 0, 1, 0, -7,
+    -5, 24, 38, -49, -141, 50, 372, 54, -769, -366,
+    1329, 935, -2078, -1657, 3233, 2074, -5379, -448, 8492, -10008,
+    6068, -2150, 426, -37
+};
+static const int16_t db17_g0[] = {
+    0, 0, 0, 0, 0, 0, 0, -1, 0, 7,
+    -5, -24, 38, 49, -141, -50, 372, -54, -769, 366,
+    1329, -935, -2078, 1657, 3233, -2074, -5379, 448, 8492, 10008,
+    6068, 2150, 426, 37
+};
+static const int16_t db17_g1[] = {
+    -37, 426, -2150, 6068, -10008, 8492, -448, -5379, 2074, 3233,
+    -1657, -2078, 935, 1329, -366, -769, 54, 372, 50, -141,
+    -49, 38, 24, -5, -7, 0, 1, 0, 0, 0,
+    0, 0, 0, 0
+};
+
+// db18 (L=36)
+static const int16_t db18_h0[] = {
+    26, 316, 1697, 5156, 9369, 9368, 2412, -4811, -3547, 2450,
+    2737, -1513, -1749, 1063, 935, -730, -389, 437, 103, -214,
+    2, 81, -18, -22, 10, 3, -3, 0, 1, 0,
+    0, 0, 0, 0, 0, 0
+};
+static const int16_t db18_h1[] = {
+    0, 0, 0, 0, 0, 0, 0, -1, 0, 3,
+    3, -10, -22, 18, 81, -2, -214, -103, 437, 389,
+    -730, -935, 1063, 1749, -1513, -2737, 2450, 3547, -4811, -2412,
+    9368, -9369, 5156, -1697, 316, -26
+};
+static const int16_t db18_g0[] = {
+    0, 0, 0, 0, 0, 0, 0, 1, 0, -3,
+    3, 10, -22, -18, 81, 2, -214, 103, 437, -389,
+    -730, 935, 1063, -1749, -1513, 2737, 2450, -3547, -4811, 2412,
+    9368, 9369, 5156, 1697, 316, 26
+};
+static const int16_t db18_g1[] = {
+    -26, 316, -1697, 5156, -9369, 9368, -2412, -4811, 3547, 2450,
+    -2737, -1513, 1749, 1063, -935, -730, 389, 437, -103, -214,
+    -2, 81, 18, -22, -10, 3, 3, 0, -1, 0,
+    0, 0, 0, 0, 0, 0
+};
+
+// db19 (L=38)
+static const int16_t db19_h0[] = {
+    18, 234, 1332, 4332, 8592, 9856, 4275, -3737, -4683, 1223,
+    3479, -549, -2339, 452, 1424, -434, -748, 354, 317, -229,
+    -96, 115, 13, -44, 6, 12, -4, -2, 1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0
+};
+static const int16_t db19_h1[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, -1,
+    -2, 4, 12, -6, -44, -13, 115, 96, -229, -317,
+    354, 748, -434, -1424, 452, 2339, -549, -3479, 1223, 4683,
+    -3737, -4275, 9856, -8592, 4332, -1332, 234, -18
+};
+static const int16_t db19_g0[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+    -2, -4, 12, 6, -44, 13, 115, -96, -229, 317,
+    354, -748, -434, 1424, 452, -2339, -549, 3479, 1223, -4683,
+    -3737, 4275, 9856, 8592, 4332, 1332, 234, 18
+};
+static const int16_t db19_g1[] = {
+    -18, 234, -1332, 4332, -8592, 9856, -4275, -3737, 4683, 1223,
+    -3479, -549, 2339, 452, -1424, -434, 748, 354, -317, -229,
+    96, 115, -13, -44, -6, 12, 4, -2, -1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0
+};
+
+// db20 (L=40)
+static const int16_t db20_h0[] = {
+    13, 173, 1039, 3604, 7745, 10002, 5923, -2281, -5354, -274,
+    3740, 653, -2547, -405, 1676, 92, -1011, 96, 529, -144,
+    -226, 110, 72, -59, -14, 23, -1, -6, 2, 1,
+    -1, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+static const int16_t db20_h1[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+    1, -2, -6, 1, 23, 14, -59, -72, 110, 226,
+    -144, -529, 96, 1011, 92, -1676, -405, 2547, 653, -3740,
+    -274, 5354, -2281, -5923, 10002, -7745, 3604, -1039, 173, -13
+};
+static const int16_t db20_g0[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, -1,
+    1, 2, -6, -1, 23, -14, -59, 72, 110, -226,
+    -144, 529, 96, -1011, 92, 1676, -405, -2547, 653, 3740,
+    -274, -5354, -2281, 5923, 10002, 7745, 3604, 1039, 173, 13
+};
+static const int16_t db20_g1[] = {
+    -13, 173, -1039, 3604, -7745, 10002, -5923, -2281, 5354, -274,
+    -3740, 653, 2547, -405, -1676, 92, 1011, 96, -529, -144,
+    226, 110, -72, -59, 14, 23, 1, -6, -2, 1,
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+// sym2 (L=4)
+static const int16_t sym2_h0[] = {
+    7913, 13705, 3672, -2120
+};
+static const int16_t sym2_h1[] = {
+    -2120, -3672, 13705, -7913
+};
+static const int16_t sym2_g0[] = {
+    -2120, 3672, 13705, 7913
+};
+static const int16_t sym2_g1[] = {
+    -7913, 13705, -3672, -2120
+};
+
+// sym3 (L=6)
+static const int16_t sym3_h0[] = {
+    5450, 13220, 7535, -2212, -1400, 577
+};
+static const int16_t sym3_h1[] = {
+    577, 1400, -2212, -7535, 13220, -5450
+};
+static const int16_t sym3_g0[] = {
+    577, -1400, -2212, 7535, 13220, 5450
+};
+static const int16_t sym3_g1[] = {
+    -5450, 13220, -7535, -2212, 1400, 577
+};
+
+// sym4 (L=8)
+static const int16_t sym4_h0[] = {
+    -1241, -486, 8153, 13169, 4880, -1626, -207, 528
+};
+static const int16_t sym4_h1[] = {
+    528, 207, -1626, -4880, 13169, -8153, -486, 1241
+};
+static const int16_t sym4_g0[] = {
+    528, -207, -1626, 4880, 13169, 8153, -486, -1241
+};
+static const int16_t sym4_g1[] = {
+    1241, -486, -8153, 13169, -4880, -1626, 207, 528
+};
+
+// sym5 (L=10)
+static const int16_t sym5_h0[] = {
+    448, 484, -641, 3267, 11852, 10387, 272, -2873, -346, 320
+};
+static const int16_t sym5_h1[] = {
+    320, 346, -2873, -272, 10387, -11852, 3267, 641, 484, -448
+};
+static const int16_t sym5_g0[] = {
+    320, -346, -2873, 272, 10387, 11852, 3267, -641, 484, 448
+};
+static const int16_t sym5_g1[] = {
+    -448, 484, 641, 3267, -11852, 10387, -272, -2873, 346, 320
+};
+
+// sym6 (L=12)
+static const int16_t sym6_h0[] = {
+    252, 57, -1933, -792, 8045, 12905, 5537, -1190, -345, 733,
+    29, -128
+};
+static const int16_t sym6_h1[] = {
+    -128, -29, 733, 345, -1190, -5537, 12905, -8045, -792, 1933,
+    57, -252
+};
+static const int16_t sym6_g0[] = {
+    -128, 29, 733, -345, -1190, 5537, 12905, 8045, -792, -1933,
+    57, 252
+};
+static const int16_t sym6_g1[] = {
+    -252, 57, 1933, -792, -8045, 12905, -5537, -1190, 345, 733,
+    -29, -128
+};
+
+// sym7 (L=14)
+static const int16_t sym7_h0[] = {
+    197, 282, -1063, -1051, 5902, 12811, 7923, -931, -1655, 733,
+    335, -297, -54, 38
+};
+static const int16_t sym7_h1[] = {
+    38, 54, -297, -335, 733, 1655, -931, -7923, 12811, -5902,
+    -1051, 1063, 282, -197
+};
+static const int16_t sym7_g0[] = {
+    38, -54, -297, 335, 733, -1655, -931, 7923, 12811, 5902,
+    -1051, -1063, 282, 197
+};
+static const int16_t sym7_g1[] = {
+    -197, 282, 1063, -1051, -5902, 12811, -7923, -931, 1655, 733,
+    -335, -297, 54, 38
+};
+
+// sym8 (L=16)
+static const int16_t sym8_h0[] = {
+    -55, -9, 519, 125, -2348, -1004, 7887, 12733, 5971, -851,
+    -446, 805, 62, -245, -5, 31
+};
+static const int16_t sym8_h1[] = {
+    31, 5, -245, -62, 805, 446, -851, -5971, 12733, -7887,
+    -1004, 2348, 125, -519, -9, 55
+};
+static const int16_t sym8_g0[] = {
+    31, -5, -245, 62, 805, -446, -851, 5971, 12733, 7887,
+    -1004, -2348, 125, 519, -9, -55
+};
+static const int16_t sym8_g1[] = {
+    55, -9, -519, 125, 2348, -1004, -7887, 12733, -5971, -851,
+    446, 805, -62, -245, 5, 31
+};
+
+// sym9 (L=18)
+static const int16_t sym9_h0[] = {
+    23, 10, -217, -189, 495, 10, -894, 3912, 11761, 10114,
+    578, -3138, -299, 1017, 145, -168, -8, 18
+};
+static const int16_t sym9_h1[] = {
+    18, 8, -168, -145, 1017, 299, -3138, -578, 10114, -11761,
+    3912, 894, 10, -495, -189, 217, 10, -23
+};
+static const int16_t sym9_g0[] = {
+    18, -8, -168, 145, 1017, -299, -3138, 578, 10114, 11761,
+    3912, -894, 10, 495, -189, -217, 10, 23
+};
+static const int16_t sym9_g1[] = {
+    -23, 10, 217, -189, -495, 10, 894, 3912, -11761, 10114,
+    -578, -3138, 299, 1017, -145, -168, 8, 18
+};
+
+// sym10 (L=20)
+static const int16_t sym10_h0[] = {
+    14, 12, -116, 10, 814, 430, -1992, -246, 8417, 12566,
+    5574, -1440, -1099, 554, -14, -377, -19, 83, 6, -7
+};
+static const int16_t sym10_h1[] = {
+    -7, -6, 83, 19, -377, 14, 554, 1099, -1440, -5574,
+    12566, -8417, -246, 1992, 430, -814, 10, 116, 12, -14
+};
+static const int16_t sym10_g0[] = {
+    -7, 6, 83, -19, -377, -14, 554, -1099, -1440, 5574,
+    12566, 8417, -246, -1992, 430, 814, 10, -116, 12, 14
+};
+static const int16_t sym10_g1[] = {
+    -14, 12, 116, 10, -814, 430, 1992, -246, -8417, 12566,
+    -5574, -1440, 1099, 554, 14, -377, 19, 83, -6, -7
+};
+
+// sym11 (L=22)
+static const int16_t sym11_h0[] = {
+    11, 23, -64, -46, 610, 835, -886, -470, 6683, 12590,
+    7406, -1336, -2457, 299, 389, -448, -141, 162, 39, -27,
+    -4, 2
+};
+static const int16_t sym11_h1[] = {
+    2, 4, -27, -39, 162, 141, -448, -389, 299, 2457,
+    -1336, -7406, 12590, -6683, -470, 886, 835, -610, -46, 64,
+    23, -11
+};
+static const int16_t sym11_g0[] = {
+    2, -4, -27, 39, 162, -141, -448, 389, 299, -2457,
+    -1336, 7406, 12590, 6683, -470, -886, 835, 610, -46, -64,
+    23, 11
+};
+static const int16_t sym11_g1[] = {
+    -11, 23, 64, -46, -610, 835, 886, -470, -6683, 12590,
+    -7406, -1336, 2457, 299, -389, -448, 141, 162, -39, -27,
+    4, 2
+};
+
+// sym12 (L=24)
+static const int16_t sym12_h0[] = {
+    -3, -3, 34, 11, -214, -21, 984, 512, -2025, -123,
+    8465, 12467, 5627, -1463, -1314, 503, 31, -418, -10, 141,
+    11, -23, -1, 2
+};
+static const int16_t sym12_h1[] = {
+    2, 1, -23, -11, 141, 10, -418, -31, 503, 1314,
+    -1463, -5627, 12467, -8465, -123, 2025, 512, -984, -21, 214,
+    11, -34, -3, 3
+};
+static const int16_t sym12_g0[] = {
+    2, -1, -23, 11, 141, -10, -418, 31, 503, -1314,
+    -1463, 5627, 12467, 8465, -123, -2025, 512, 984, -21, -214,
+    11, 34, -3, -3
+};
+static const int16_t sym12_g1[] = {
+    3, -3, -34, 11, 214, -21, -984, 512, 2025, -123,
+    -8465, 12467, -5627, -1463, 1314, 503, -31, -418, 10, 141,
+    -11, -23, 1, 2
+};
+
+// sym13 (L=26)
+static const int16_t sym13_h0[] = {
+    1, -1, -19, -3, 123, 87, -331, -282, 227, -979,
+    -2038, 3239, 11398, 10561, 1806, -2302, 145, 1523, 289, -340,
+    -24, 93, 7, -12, 1, 1
+};
+static const int16_t sym13_h1[] = {
+    1, -1, -12, -7, 93, 24, -340, -289, 1523, -145,
+    -2302, -1806, 10561, -11398, 3239, 2038, -979, -227, -282, 331,
+    87, -123, -3, 19, -1, -1
+};
+static const int16_t sym13_g0[] = {
+    1, 1, -12, 7, 93, -24, -340, 289, 1523, 145,
+    -2302, 1806, 10561, 11398, 3239, -2038, -979, 227, -282, -331,
+    87, 123, -3, -19, -1, 1
+};
+static const int16_t sym13_g1[] = {
+    -1, -1, 19, -3, -123, 87, 331, -282, -227, -979,
+    2038, 3239, -11398, 10561, -1806, -2302, -145, 1523, -289, -340,
+    24, 93, -7, -12, -1, 1
+};
+
+// sym14 (L=28)
+static const int16_t sym14_h0[] = {
+    1, 1, -9, -4, 68, 24, -285, -15, 1174, 706,
+    -1766, 332, 8727, 12319, 5340, -1852, -1730, 357, 56, -440,
+    0, 197, 14, -47, -4, 6, 0, 0
+};
+static const int16_t sym14_h1[] = {
+    0, 0, 6, 4, -47, -14, 197, 0, -440, -56,
+    357, 1730, -1852, -5340, 12319, -8727, 332, 1766, 706, -1174,
+    -15, 285, 24, -68, -4, 9, 1, -1
+};
+static const int16_t sym14_g0[] = {
+    0, 0, 6, -4, -47, 14, 197, 0, -440, 56,
+    357, -1730, -1852, 5340, 12319, 8727, 332, -1766, 706, 1174,
+    -15, -285, 24, 68, -4, -9, 1, 1
+};
+static const int16_t sym14_g1[] = {
+    -1, 1, 9, -4, -68, 24, 285, -15, -1174, 706,
+    1766, 332, -8727, 12319, -5340, -1852, 1730, 357, -56, -440,
+    0, 197, -14, -47, 4, 6, 0, 0
+};
+
+// sym15 (L=30)
+static const int16_t sym15_h0[] = {
+    1, 1, -7, -12, 40, 41, -227, -223, 744, 926,
+    -1153, -614, 6688, 12462, 7565, -997, -2515, 218, 562, -406,
+    -171, 255, 77, -81, -21, 16, 3, -2, 0, 0
+};
+static const int16_t sym15_h1[] = {
+    0, 0, -2, -3, 16, 21, -81, -77, 255, 171,
+    -406, -562, 218, 2515, -997, -7565, 12462, -6688, -614, 1153,
+    926, -744, -223, 227, 41, -40, -12, 7, 1, -1
+};
+static const int16_t sym15_g0[] = {
+    0, 0, -2, 3, 16, -21, -81, 77, 255, -171,
+    -406, 562, 218, -2515, -997, 7565, 12462, 6688, -614, -1153,
+    926, 744, -223, -227, 41, 40, -12, -7, 1, 1
+};
+static const int16_t sym15_g1[] = {
+    -1, 1, 7, -12, -40, 41, 227, -223, -744, 926,
+    1153, -614, -6688, 12462, -7565, -997, 2515, 218, -562, -406,
+    171, 255, -77, -81, 21, 16, -3, -2, 0, 0
+};
+
+// sym16 (L=32)
+static const int16_t sym16_h0[] = {
+    0, 0, 3, 2, -20, -8, 102, 27, -376, -49,
+    1272, 765, -1718, 491, 8794, 12234, 5294, -1948, -1913, 320,
+    131, -429, 9, 241, 14, -74, -7, 14, 1, -2,
+    0, 0
+};
+static const int16_t sym16_h1[] = {
+    0, 0, -2, -1, 14, 7, -74, -14, 241, -9,
+    -429, -131, 320, 1913, -1948, -5294, 12234, -8794, 491, 1718,
+    765, -1272, -49, 376, 27, -102, -8, 20, 2, -3,
+    0, 0
+};
+static const int16_t sym16_g0[] = {
+    0, 0, -2, 1, 14, -7, -74, 14, 241, 9,
+    -429, 131, 320, -1913, -1948, 5294, 12234, 8794, 491, -1718,
+    765, 1272, -49, -376, 27, 102, -8, -20, 2, 3,
+    0, 0
+};
+static const int16_t sym16_g1[] = {
+    0, 0, -3, 2, 20, -8, -102, 27, 376, -49,
+    -1272, 765, 1718, 491, -8794, 12234, -5294, -1948, 1913, 320,
+    -131, -429, -9, 241, -14, -74, 7, 14, -1, -2,
+    0, 0
+};
+
+// sym17 (L=34)
+static const int16_t sym17_h0[] = {
+    0, 0, -1, 0, 12, 1, -64, -31, 203, 163,
+    -296, -119, 265, -1410, -2541, 2958, 11165, 10661, 2333, -1943,
+    283, 1716, 293, -545, -79, 172, 14, -45, -2, 8,
+    0, -1, 0, 0
+};
+static const int16_t sym17_h1[] = {
+    0, 0, -1, 0, 8, 2, -45, -14, 172, 79,
+    -545, -293, 1716, -283, -1943, -2333, 10661, -11165, 2958, 2541,
+    -1410, -265, -119, 296, 163, -203, -31, 64, 1, -12,
+    0, 1, 0, 0
+};
+static const int16_t sym17_g0[] = {
+    0, 0, -1, 0, 8, -2, -45, 14, 172, -79,
+    -545, 293, 1716, 283, -1943, 2333, 10661, 11165, 2958, -2541,
+    -1410, 265, -119, -296, 163, 203, -31, -64, 1, 12,
+    0, -1, 0, 0
+};
+static const int16_t sym17_g1[] = {
+    0, 0, 1, 0, -12, 1, 64, -31, -203, 163,
+    296, -119, -265, -1410, 2541, 2958, -11165, 10661, -2333, -1943,
+    -283, 1716, -293, -545, 79, 172, -14, -45, 2, 8,
+    0, -1, 0, 0
+};
+
+// sym18 (L=36)
+static const int16_t sym18_h0[] = {
+    0, 0, -1, 0, 7, 2, -35, -5, 158, 46,
+    -446, -13, 1478, 787, -2134, -195, 8241, 12309, 6047, -1210,
+    -1708, 221, 10, -547, -51, 257, 22, -87, -3, 24,
+    1, -5, 0, 0, 0, 0
+};
+static const int16_t sym18_h1[] = {
+    0, 0, 0, 0, -5, -1, 24, 3, -87, -22,
+    257, 51, -547, -10, 221, 1708, -1210, -6047, 12309, -8241,
+    -195, 2134, 787, -1478, -13, 446, 46, -158, -5, 35,
+    2, -7, 0, 1, 0, 0
+};
+static const int16_t sym18_g0[] = {
+    0, 0, 0, 0, -5, 1, 24, -3, -87, 22,
+    257, -51, -547, 10, 221, -1708, -1210, 6047, 12309, 8241,
+    -195, -2134, 787, 1478, -13, -446, 46, 158, -5, -35,
+    2, 7, 0, -1, 0, 0
+};
+static const int16_t sym18_g1[] = {
+    0, 0, 1, 0, -7, 2, 35, -5, -158, 46,
+    446, -13, -1478, 787, 2134, -195, -8241, 12309, -6047, -1210,
+    1708, 221, -10, -547, 51, 257, -22, -87, 3, 24,
+    -1, -5, 0, 0, 0, 0
+};
+
+// sym19 (L=38)
+static const int16_t sym19_h0[] = {
+    0, 0, -1, -1, 4, 6, -23, -26, 98, 92,
+    -343, -329, 882, 1073, -1111, -404, 6889, 12354, 7427, -1090,
+    -2777, 62, 676, -347, -205, 300, 101, -138, -43, 42,
+    12, -9, -2, 1, 0, 0, 0, 0
+};
+static const int16_t sym19_h1[] = {
+    0, 0, 0, 0, 1, 2, -9, -12, 42, 43,
+    -138, -101, 300, 205, -347, -676, 62, 2777, -1090, -7427,
+    12354, -6889, -404, 1111, 1073, -882, -329, 343, 92, -98,
+    -26, 23, 6, -4, -1, 1, 0, 0
+};
+static const int16_t sym19_g0[] = {
+    0, 0, 0, 0, 1, -2, -9, 12, 42, -43,
+    -138, 101, 300, -205, -347, 676, 62, -2777, -1090, 7427,
+    12354, 6889, -404, -1111, 1073, 882, -329, -343, 92, 98,
+    -26, -23, 6, 4, -1, -1, 0, 0
+};
+static const int16_t sym19_g1[] = {
+    0, 0, 1, -1, -4, 6, 23, -26, -98, 92,
+    343, -329, -882, 1073, 1111, -404, -6889, 12354, -7427, -1090,
+    2777, 62, -676, -347, 205, 300, -101, -138, 43, 42,
+    -12, -9, 2, 1, 0, 0, 0, 0
+};
+
+// sym20 (L=40)
+static const int16_t sym20_h0[] = {
+    0, 0, 0, 0, -2, -1, 12, 3, -53, -9,
+    199, 52, -519, -27, 1575, 880, -2019, -9, 8327, 12246,
+    5963, -1356, -1922, 126, 41, -533, -40, 296, 29, -111,
+    -6, 35, 2, -9, -1, 1, 0, 0, 0, 0
+};
+static const int16_t sym20_h1[] = {
+    0, 0, 0, 0, 1, 1, -9, -2, 35, 6,
+    -111, -29, 296, 40, -533, -41, 126, 1922, -1356, -5963,
+    12246, -8327, -9, 2019, 880, -1575, -27, 519, 52, -199,
+    -9, 53, 3, -12, -1, 2, 0, 0, 0, 0
+};
+static const int16_t sym20_g0[] = {
+    0, 0, 0, 0, 1, -1, -9, 2, 35, -6,
+    -111, 29, 296, -40, -533, 41, 126, -1922, -1356, 5963,
+    12246, 8327, -9, -2019, 880, 1575, -27, -519, 52, 199,
+    -9, -53, 3, 12, -1, -2, 0, 0, 0, 0
+};
+static const int16_t sym20_g1[] = {
+    0, 0, 0, 0, 2, -1, -12, 3, 53, -9,
+    -199, 52, 519, -27, -1575, 880, 2019, -9, -8327, 12246,
+    -5963, -1356, 1922, 126, -41, -533, 40, 296, -29, -111,
+    6, 35, -2, -9, 1, 1, 0, 0, 0, 0
+};
+
+// coif1 (L=6)
+static const int16_t coif1_h0[] = {
+    -1192, 5536, 13969, 6306, -1192, -257
+};
+static const int16_t coif1_h1[] = {
+    -257, 1192, 6306, -13969, 5536, 1192
+};
+static const int16_t coif1_g0[] = {
+    -257, -1192, 6306, 13969, 5536, -1192
+};
+static const int16_t coif1_g1[] = {
+    1192, 5536, -13969, 6306, 1192, -257
+};
+
+// coif2 (L=12)
+static const int16_t coif2_h0[] = {
+    268, -679, -1104, 6326, 13316, 6832, -1253, -974, 388, 92,
+    -30, -12
+};
+static const int16_t coif2_h1[] = {
+    -12, 30, 92, -388, -974, 1253, 6832, -13316, 6326, 1104,
+    -679, -268
+};
+static const int16_t coif2_g0[] = {
+    -12, -30, 92, 388, -974, -1253, 6832, 13316, 6326, -1104,
+    -679, 268
+};
+static const int16_t coif2_g1[] = {
+    -268, -679, 1104, 6326, -13316, 6832, 1253, -974, -388, 92,
+    30, -12
+};
+
+// coif3 (L=18)
+static const int16_t coif3_h0[] = {
+    -62, 128, 384, -1078, -1001, 6638, 13005, 7020, -1176, -1348,
+    566, 260, -148, -42, 18, 8, -1, -1
+};
+static const int16_t coif3_h1[] = {
+    -1, 1, 8, -18, -42, 148, 260, -566, -1348, 1176,
+    7020, -13005, 6638, 1001, -1078, -384, 128, 62
+};
+static const int16_t coif3_g0[] = {
+    -1, -1, 8, 18, -42, -148, 260, 566, -1348, -1176,
+    7020, 13005, 6638, -1001, -1078, 384, 128, -62
+};
+static const int16_t coif3_g1[] = {
+    62, 128, -384, -1078, 1001, 6638, -13005, 7020, 1176, -1348,
+    -566, 260, 148, -42, -18, 8, 1, -1
+};
+
+// coif4 (L=24)
+static const int16_t coif4_h0[] = {
+    15, -27, -120, 263, 437, -1331, -919, 6804, 12816, 7117,
+    -1092, -1576, 644, 411, -249, -93, 61, 21, -10, -4,
+    1, 1, 0, 0
+};
+static const int16_t coif4_h1[] = {
+    0, 0, 1, -1, -4, 10, 21, -61, -93, 249,
+    411, -644, -1576, 1092, 7117, -12816, 6804, 919, -1331, -437,
+    263, 120, -27, -15
+};
+static const int16_t coif4_g0[] = {
+    0, 0, 1, 1, -4, -10, 21, 61, -93, -249,
+    411, 644, -1576, -1092, 7117, 12816, 6804, -919, -1331, 437,
+    263, -120, -27, 15
+};
+static const int16_t coif4_g1[] = {
+    -15, -27, 120, 263, -437, -1331, 919, 6804, -12816, 7117,
+    1092, -1576, -644, 411, 249, -93, -61, 21, 10, -4,
+    -1, 1, 0, 0
+};
+
+// coif5 (L=30)
+static const int16_t coif5_h0[] = {
+    -3, 5, 32, -58, -155, 347, 452, -1433, -871, 6833,
+    12742, 7184, -1074, -1650, 687, 423, -287, -70, 67, 7,
+    -4, -2, -2, 0, 0, 0, 0, 0, 0, 0
+};
+static const int16_t coif5_h1[] = {
+    0, 0, 0, 0, 0, 0, 0, 2, -2, 4,
+    7, -67, -70, 287, 423, -687, -1650, 1074, 7184, -12742,
+    6833, 871, -1433, -452, 347, 155, -58, -32, 5, 3
+};
+static const int16_t coif5_g0[] = {
+    0, 0, 0, 0, 0, 0, 0, -2, -2, -4,
+    7, 67, -70, -287, 423, 687, -1650, -1074, 7184, 12742,
+    6833, -871, -1433, 452, 347, -155, -58, 32, 5, -3
+};
+static const int16_t coif5_g1[] = {
+    3, 5, -32, -58, 155, 347, -452, -1433, 871, 6833,
+    -12742, 7184, 1074, -1650, -687, 423, 287, -70, -67, 7,
+    4, -2, 2, 0, 0, 0, 0, 0, 0, 0
+};
+
+const wavelet_kernel_set_t wavelet_family_kernels[WAVELET_FAMILY_COUNT] = {
+    { db2_h0, db2_h1, db2_g0, db2_g1, 4 },
+    { db3_h0, db3_h1, db3_g0, db3_g1, 6 },
+    { db4_h0, db4_h1, db4_g0, db4_g1, 8 },
+    { db5_h0, db5_h1, db5_g0, db5_g1, 10 },
+    { db6_h0, db6_h1, db6_g0, db6_g1, 12 },
+    { db7_h0, db7_h1, db7_g0, db7_g1, 14 },
+    { db8_h0, db8_h1, db8_g0, db8_g1, 16 },
+    { db9_h0, db9_h1, db9_g0, db9_g1, 18 },
+    { db10_h0, db10_h1, db10_g0, db10_g1, 20 },
+    { db11_h0, db11_h1, db11_g0, db11_g1, 22 },
+    { db12_h0, db12_h1, db12_g0, db12_g1, 24 },
+    { db13_h0, db13_h1, db13_g0, db13_g1, 26 },
+    { db14_h0, db14_h1, db14_g0, db14_g1, 28 },
+    { db15_h0, db15_h1, db15_g0, db15_g1, 30 },
+    { db16_h0, db16_h1, db16_g0, db16_g1, 32 },
+    { db17_h0, db17_h1, db17_g0, db17_g1, 34 },
+    { db18_h0, db18_h1, db18_g0, db18_g1, 36 },
+    { db19_h0, db19_h1, db19_g0, db19_g1, 38 },
+    { db20_h0, db20_h1, db20_g0, db20_g1, 40 },
+    { sym2_h0, sym2_h1, sym2_g0, sym2_g1, 4 },
+    { sym3_h0, sym3_h1, sym3_g0, sym3_g1, 6 },
+    { sym4_h0, sym4_h1, sym4_g0, sym4_g1, 8 },
+    { sym5_h0, sym5_h1, sym5_g0, sym5_g1, 10 },
+    { sym6_h0, sym6_h1, sym6_g0, sym6_g1, 12 },
+    { sym7_h0, sym7_h1, sym7_g0, sym7_g1, 14 },
+    { sym8_h0, sym8_h1, sym8_g0, sym8_g1, 16 },
+    { sym9_h0, sym9_h1, sym9_g0, sym9_g1, 18 },
+    { sym10_h0, sym10_h1, sym10_g0, sym10_g1, 20 },
+    { sym11_h0, sym11_h1, sym11_g0, sym11_g1, 22 },
+    { sym12_h0, sym12_h1, sym12_g0, sym12_g1, 24 },
+    { sym13_h0, sym13_h1, sym13_g0, sym13_g1, 26 },
+    { sym14_h0, sym14_h1, sym14_g0, sym14_g1, 28 },
+    { sym15_h0, sym15_h1, sym15_g0, sym15_g1, 30 },
+    { sym16_h0, sym16_h1, sym16_g0, sym16_g1, 32 },
+    { sym17_h0, sym17_h1, sym17_g0, sym17_g1, 34 },
+    { sym18_h0, sym18_h1, sym18_g0, sym18_g1, 36 },
+    { sym19_h0, sym19_h1, sym19_g0, sym19_g1, 38 },
+    { sym20_h0, sym20_h1, sym20_g0, sym20_g1, 40 },
+    { coif1_h0, coif1_h1, coif1_g0, coif1_g1, 6 },
+    { coif2_h0, coif2_h1, coif2_g0, coif2_g1, 12 },
+    { coif3_h0, coif3_h1, coif3_g0, coif3_g1, 18 },
+    { coif4_h0, coif4_h1, coif4_g0, coif4_g1, 24 },
+    { coif5_h0, coif5_h1, coif5_g0, coif5_g1, 30 }
+};
@@ -0,0 +1,31 @@
+/**
+ * @file wavelet_tables.h
+ * @brief Internal lookup for the generated Daubechies, Symlet and Coiflet filter banks.
+ */
+
+#ifndef WAVELET_TABLES_H
+#define WAVELET_TABLES_H
+
+#include "wavelet_filter.h"
+
+#define WAVELET_FAMILY_FIRST WAVELET_DAUBECHIES_2
+#define WAVELET_FAMILY_LAST WAVELET_COIFLET_5
+#define WAVELET_FAMILY_COUNT (WAVELET_FAMILY_LAST - WAVELET_FAMILY_FIRST + 1)
+
+/**
+ * @brief One Q14 filter bank: analysis pair h0/h1 and synthesis pair g0/g1.
+ */
+typedef struct {
+    const int16_t* h0;
+    const int16_t* h1;
+    const int16_t* g0;
+    const int16_t* g1;
+    uint8_t len;
+} wavelet_kernel_set_t;
+
+/**
+ * @brief Banks indexed by wavelet - WAVELET_FAMILY_FIRST (db2..db20, sym2..sym20, coif1..coif5).
+ */
+extern const wavelet_kernel_set_t wavelet_family_kernels[WAVELET_FAMILY_COUNT];
+
+#endif // WAVELET_TABLES_H